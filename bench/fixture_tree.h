@@ -0,0 +1,105 @@
+#ifndef FIXTURE_TREE_H
+#define FIXTURE_TREE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <initializer_list>
+#include <cstdlib>
+#include <cstring>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Helpers for building throwaway sysfs-like directory trees under /tmp for the benchmarks.
+class FixtureTree {
+public:
+    FixtureTree() {
+        char path_template[] = "/tmp/system_monitor_fixture.XXXXXX";
+        char* created = mkdtemp(path_template);
+        root_ = created ? created : "";
+    }
+
+    ~FixtureTree() {
+        if (!root_.empty()) {
+            nftw(root_.c_str(), removeEntry, 64, FTW_DEPTH | FTW_PHYS);
+        }
+    }
+
+    FixtureTree(const FixtureTree&) = delete;
+    FixtureTree& operator=(const FixtureTree&) = delete;
+
+    const std::string& root() const { return root_; }
+
+    void makeDirs(const std::string& relative_path) const {
+        std::string path = root_;
+        size_t pos = 0;
+        while (pos != std::string::npos) {
+            size_t next = relative_path.find('/', pos);
+            path += "/" + relative_path.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+            mkdir(path.c_str(), 0755);
+            pos = next == std::string::npos ? next : next + 1;
+        }
+    }
+
+    void writeFile(const std::string& relative_path, const std::string& contents) const {
+        size_t slash = relative_path.rfind('/');
+        if (slash != std::string::npos) {
+            makeDirs(relative_path.substr(0, slash));
+        }
+        std::ofstream file(root_ + "/" + relative_path, std::ios::trunc);
+        file << contents;
+    }
+
+private:
+    std::string root_;
+
+    static int removeEntry(const char* path, const struct stat*, int, struct FTW*) {
+        return remove(path);
+    }
+};
+
+// Shared by the benchmark programs: timing, "--name value" options and asserting checks.
+
+inline double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+struct IntOption {
+    const char* name;
+    int* value;
+    int minimum;
+};
+
+// Unknown flags are ignored; values below the option's minimum are clamped to it.
+inline void parseIntOptions(int argc, char* argv[], std::initializer_list<IntOption> options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        for (const IntOption& option : options) {
+            if (std::strcmp(argv[i], option.name) == 0) {
+                *option.value = std::max(option.minimum, std::atoi(argv[i + 1]));
+            }
+        }
+    }
+}
+
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void expect(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++checkFailures();
+    }
+}
+
+#endif
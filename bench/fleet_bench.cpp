@@ -0,0 +1,141 @@
+// Aggregator throughput benchmark: N simulated agents connected over a Unix socket each send one
+// delta-encoded snapshot per tick, and the aggregator's CPU time per tick is measured on its thread.
+//
+// Usage: fleet_bench [--agents N] [--ticks T] [--sensors M]
+
+#include "fleet_aggregator.h"
+#include "snapshot_stream.h"
+#include "stream_endpoint.h"
+#include "fixture_tree.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+double threadCpuMilliseconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+}
+
+struct SimulatedAgent {
+    int fd;
+    std::string hostname;
+    HostSnapshot snapshot;
+    SnapshotEncoder encoder;
+};
+
+bool sendAll(int fd, const std::vector<uint8_t>& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                usleep(100);
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int agent_count = 1000;
+    int ticks = 30;
+    int sensors = 8;
+
+    parseIntOptions(argc, argv, {{"--agents", &agent_count, 1}, {"--ticks", &ticks, 2}, {"--sensors", &sensors, 0}});
+
+    // Both ends of every connection live in this process, as main() does for the real aggregator.
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    StreamEndpoint endpoint;
+    parseStreamEndpoint("unix:/tmp/system_monitor_fleet_bench." + std::to_string(getpid()) + ".sock", endpoint);
+    FleetAggregator aggregator(endpoint);
+    if (!aggregator.start()) {
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::vector<SimulatedAgent> agents(static_cast<size_t>(agent_count));
+    for (int i = 0; i < agent_count; ++i) {
+        SimulatedAgent& agent = agents[static_cast<size_t>(i)];
+        agent.fd = connectStreamEndpoint(endpoint, 5000);
+        if (agent.fd < 0) {
+            std::cerr << "Could only connect " << i << " agents (check ulimit -n)" << std::endl;
+            return 1;
+        }
+        agent.hostname = "host" + std::to_string(i);
+        agent.snapshot.fields[FIELD_MEM_TOTAL_KB] = 64LL * 1024 * 1024;
+        agent.snapshot.fields[FIELD_DISK_TOTAL_GB] = 1000;
+        for (int s = 0; s < sensors; ++s) {
+            agent.snapshot.sensor_names.push_back("Core " + std::to_string(s));
+            agent.snapshot.temperatures_centi.push_back(4000 + static_cast<int64_t>(rng() % 3000));
+        }
+        aggregator.poll(0);
+    }
+
+    std::vector<uint8_t> frame;
+    std::vector<double> tick_cpu_ms;
+    uint64_t bytes_sent = 0;
+    for (int tick = 0; tick <= ticks; ++tick) {
+        for (SimulatedAgent& agent : agents) {
+            HostSnapshot& snapshot = agent.snapshot;
+            snapshot.sequence = static_cast<uint64_t>(tick);
+            snapshot.fields[FIELD_TIMESTAMP_MS] += 1000;
+            snapshot.fields[FIELD_CPU_PERMILLE] = static_cast<int64_t>(rng() % 1000);
+            snapshot.fields[FIELD_MEM_USED_KB] += static_cast<int64_t>(rng() % 2048) - 1024;
+            for (int64_t& temp : snapshot.temperatures_centi) {
+                if (rng() % 2 == 0) temp += static_cast<int64_t>(rng() % 200) - 100;
+            }
+            frame.clear();
+            agent.encoder.encode(snapshot, agent.hostname, frame);
+            bytes_sent += frame.size();
+            if (!sendAll(agent.fd, frame)) {
+                std::cerr << "Send failed for " << agent.hostname << std::endl;
+                return 1;
+            }
+        }
+
+        uint64_t expected = static_cast<uint64_t>(tick + 1) * static_cast<uint64_t>(agent_count);
+        double start = threadCpuMilliseconds();
+        while (aggregator.framesReceived() < expected) {
+            aggregator.poll(10);
+        }
+        // Tick 0 carries the keyframes and connection setup; only steady-state deltas are reported.
+        if (tick > 0) {
+            tick_cpu_ms.push_back(threadCpuMilliseconds() - start);
+        }
+    }
+
+    double median_ms = median(tick_cpu_ms);
+    double worst_ms = *std::max_element(tick_cpu_ms.begin(), tick_cpu_ms.end());
+
+    std::cout << agent_count << " agents, " << sensors << " sensors each, " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  average frame size: " << static_cast<double>(bytes_sent) / (static_cast<double>(agent_count) * (ticks + 1)) << " bytes" << std::endl;
+    std::cout << "  aggregator CPU per tick: median " << median_ms << " ms, worst " << worst_ms << " ms" << std::endl;
+    std::cout << "  single-core utilisation at 1 Hz: " << median_ms / 10.0 << " %" << std::endl;
+
+    for (SimulatedAgent& agent : agents) {
+        close(agent.fd);
+    }
+    return 0;
+}
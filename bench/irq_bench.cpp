@@ -0,0 +1,152 @@
+// IRQ parser benchmark: times IrqTable::update() on a synthetic /proc/interrupts with one column per
+// CPU, after checking the parser on a few hand-written tables (32-bit wrap, short ERR/MIS rows,
+// layout changes, malformed cells).
+//
+// Usage: irq_bench [--cpus N] [--irqs M] [--ticks T]
+
+#include "irq_stats.h"
+#include "fixture_tree.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string buildInterrupts(int cpus, int irqs, std::mt19937& rng) {
+    std::string text = "          ";
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        text += "  CPU" + std::to_string(cpu);
+    }
+    text += "\n";
+
+    // Most cells on a big machine are zero or small; a few queues carry most of the traffic.
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::uniform_int_distribution<uint32_t> small(1, 9999);
+    std::uniform_int_distribution<uint32_t> large(100000, 4000000000U);
+    char cell[16];
+    for (int irq = 0; irq < irqs; ++irq) {
+        std::snprintf(cell, sizeof(cell), "%4d:", irq);
+        text += cell;
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            int k = kind(rng);
+            uint32_t value = k < 6 ? 0 : (k < 9 ? small(rng) : large(rng));
+            std::snprintf(cell, sizeof(cell), " %10u", value);
+            text += cell;
+        }
+        text += "  IR-PCI-MSI 524288-edge      eth0-TxRx-" + std::to_string(irq) + "\n";
+    }
+    text += " NMI:";
+    for (int cpu = 0; cpu < cpus; ++cpu) text += "          0";
+    text += "   Non-maskable interrupts\n";
+    text += " ERR:          0\n";
+    text += " MIS:          0\n";
+    return text;
+}
+
+void checkParser(const FixtureTree& tree) {
+    const std::string path = tree.root() + "/check_interrupts";
+
+    tree.writeFile("check_interrupts",
+        "           CPU0       CPU1\n"
+        "  0:  4294967290         12   IO-APIC    2-edge      timer\n"
+        "NMI:          3          4   Non-maskable interrupts\n"
+        "ERR:          7\n"
+        "MIS:          0\n");
+    IrqTable table(path);
+    expect(table.update(), "first update succeeds");
+    expect(table.rows() == 4 && table.cols() == 2, "4 rows x 2 columns");
+    expect(table.counts()[0] == 4294967290ULL, "large counter parsed");
+    expect(table.irqDescriptions()[0] == "IO-APIC    2-edge      timer", "description kept");
+    expect(table.counts()[2 * 2] == 7 && table.counts()[2 * 2 + 1] == 0, "short ERR row fills one column");
+    expect(table.irqNames()[3] == "MIS", "MIS row named");
+    expect(table.intervalSeconds() == 0.0, "no interval on first sample");
+
+    // The first counter wraps past 2^32: 4294967290 -> 4 is a delta of 10.
+    tree.writeFile("check_interrupts",
+        "           CPU0       CPU1\n"
+        "  0:          4         15   IO-APIC    2-edge      timer\n"
+        "NMI:          3          4   Non-maskable interrupts\n"
+        "ERR:          9\n"
+        "MIS:          0\n");
+    expect(table.update(), "second update succeeds");
+    expect(table.deltas()[0] == 10, "32-bit wrap delta");
+    expect(table.deltas()[1] == 3, "plain delta");
+    expect(table.deltas()[2 * 2] == 2, "ERR delta");
+    expect(table.intervalSeconds() > 0.0, "interval after second sample");
+
+    // A CPU coming online changes the layout; the next sample must not be diffed against the old one.
+    tree.writeFile("check_interrupts",
+        "           CPU0       CPU1       CPU2\n"
+        "  0:          5         16          1   IO-APIC    2-edge      timer\n"
+        "NMI:          3          4          0   Non-maskable interrupts\n"
+        "ERR:          9\n"
+        "MIS:          0\n");
+    expect(table.update(), "update after layout change succeeds");
+    expect(table.cols() == 3, "new column picked up");
+    expect(std::all_of(table.deltas().begin(), table.deltas().end(), [](uint32_t d) { return d == 0; }),
+           "deltas reset after layout change");
+    expect(table.intervalSeconds() == 0.0, "interval reset after layout change");
+
+    expect(table.update(), "update after reset succeeds");
+    expect(table.intervalSeconds() > 0.0, "deltas resume on the following sample");
+
+    // Cells that are not a space-padded run of digits must not go through the fixed-width
+    // conversion: "       1#2" would read as 132 and "       1 4" as 104.
+    tree.writeFile("check_malformed",
+        "           CPU0       CPU1\n"
+        "  0:        1#2         12   IO-APIC    2-edge      timer\n"
+        "  1:        1 4         12   IO-APIC    1-edge      i8042\n");
+    IrqTable malformed(tree.root() + "/check_malformed");
+    expect(malformed.update(), "update of malformed table succeeds");
+    expect(malformed.rows() == 2, "malformed rows kept");
+    expect(malformed.counts()[0] == 1 && malformed.counts()[1] == 0, "stray character ends the row");
+    expect(malformed.counts()[2] == 1 && malformed.counts()[3] == 4, "embedded space splits the cell");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int cpus = 256;
+    int irqs = 400;
+    int ticks = 200;
+
+    parseIntOptions(argc, argv, {{"--cpus", &cpus, 1}, {"--irqs", &irqs, 1}, {"--ticks", &ticks, 1}});
+
+    FixtureTree tree;
+    if (tree.root().empty()) {
+        std::cerr << "Could not create fixture directory" << std::endl;
+        return 1;
+    }
+
+    checkParser(tree);
+    if (checkFailures() > 0) {
+        std::cerr << checkFailures() << " parser check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::string text = buildInterrupts(cpus, irqs, rng);
+    tree.writeFile("interrupts", text);
+
+    IrqTable table(tree.root() + "/interrupts");
+    table.update();
+
+    std::vector<double> tick_ms;
+    for (int tick = 0; tick < ticks; ++tick) {
+        Clock::time_point start = Clock::now();
+        table.update();
+        tick_ms.push_back(millisecondsSince(start));
+    }
+
+    std::cout << "Parser checks passed" << std::endl;
+    std::cout << "Synthetic /proc/interrupts: " << table.rows() << " rows x " << table.cols() << " CPUs ("
+              << text.size() / 1024 << " KiB), " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  update: " << median(tick_ms) << " ms median, "
+              << *std::max_element(tick_ms.begin(), tick_ms.end()) << " ms max" << std::endl;
+    return 0;
+}
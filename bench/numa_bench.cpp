@@ -0,0 +1,156 @@
+// NUMA benchmark: times NumaStats::update() on a synthetic /sys/devices/system/node tree and
+// /proc/stat, after checking the per-node memory and CPU figures on a hand-written two-node tree.
+//
+// Usage: numa_bench [--nodes N] [--cpus-per-node C] [--ticks T]
+
+#include "numa_stats.h"
+#include "fixture_tree.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t HISTORY_POINTS = 60;
+
+std::string nodeMeminfo(int node, long total_kb, long free_kb, long file_pages_kb, long slab_reclaimable_kb) {
+    std::string prefix = "Node " + std::to_string(node) + " ";
+    return prefix + "MemTotal:       " + std::to_string(total_kb) + " kB\n" +
+           prefix + "MemFree:        " + std::to_string(free_kb) + " kB\n" +
+           prefix + "MemUsed:        " + std::to_string(total_kb - free_kb) + " kB\n" +
+           prefix + "FilePages:      " + std::to_string(file_pages_kb) + " kB\n" +
+           prefix + "SReclaimable:   " + std::to_string(slab_reclaimable_kb) + " kB\n";
+}
+
+std::string nodeNumastat(uint64_t hit, uint64_t miss, uint64_t foreign) {
+    return "numa_hit " + std::to_string(hit) + "\nnuma_miss " + std::to_string(miss) +
+           "\nnuma_foreign " + std::to_string(foreign) + "\ninterleave_hit 0\nlocal_node " +
+           std::to_string(hit) + "\nother_node " + std::to_string(miss) + "\n";
+}
+
+bool near(double value, double expected) {
+    return std::fabs(value - expected) < 1e-6;
+}
+
+void checkTwoNodes(const FixtureTree& tree) {
+    // Node 0: used = total - (free + FilePages + SReclaimable) = 16 GB - 8 GB.
+    // Node 1: free + page cache exceeds the total, so nothing counts as used.
+    tree.writeFile("check/devices/system/node/node0/cpulist", "0-1\n");
+    tree.writeFile("check/devices/system/node/node0/meminfo", nodeMeminfo(0, 16000000, 4000000, 3000000, 1000000));
+    tree.writeFile("check/devices/system/node/node0/numastat", nodeNumastat(1000, 10, 5));
+    tree.writeFile("check/devices/system/node/node1/cpulist", "2-3\n");
+    tree.writeFile("check/devices/system/node/node1/meminfo", nodeMeminfo(1, 8000000, 6000000, 3000000, 0));
+    tree.writeFile("check/devices/system/node/node1/numastat", nodeNumastat(2000, 0, 10));
+
+    // Columns: user nice system idle iowait irq softirq steal guest guest_nice.
+    const std::string first_stat =
+        "cpu  400 0 400 2800 400 0 0 0 0 0\n"
+        "cpu0 100 0 100 700 100 0 0 0 0 0\n"
+        "cpu1 100 0 100 700 100 0 0 0 0 0\n"
+        "cpu2 100 0 100 700 100 0 0 0 0 0\n"
+        "cpu3 100 0 100 700 100 0 0 0 0 0\n"
+        "intr 0\n";
+    // Node 0: per CPU +50 user, +25 idle, +25 iowait and +100 guest, so 150 of 200 ticks are busy;
+    // the guest column only counts when all 10 columns are summed, and iowait counts as idle.
+    // Node 1: cpu2 +100 idle, cpu3 +100 idle and +100 steal, so 100 of 300 ticks are busy.
+    const std::string second_stat =
+        "cpu  500 0 400 3050 450 0 0 100 200 0\n"
+        "cpu0 150 0 100 725 125 0 0 0 100 0\n"
+        "cpu1 150 0 100 725 125 0 0 0 100 0\n"
+        "cpu2 100 0 100 800 100 0 0 0 0 0\n"
+        "cpu3 100 0 100 800 100 0 0 100 0 0\n"
+        "intr 0\n";
+
+    NumaStats stats(tree.root() + "/check", HISTORY_POINTS);
+    stats.update(first_stat.data(), first_stat.size());
+    expect(stats.isMultiNode() && stats.nodes().size() == 2, "two nodes discovered");
+    if (stats.nodes().size() != 2) return;
+    const NumaNode& node0 = stats.nodes()[0];
+    const NumaNode& node1 = stats.nodes()[1];
+
+    expect(node0.cpus == std::vector<int>({0, 1}) && node1.cpus == std::vector<int>({2, 3}), "cpulists parsed");
+    expect(stats.nodeOfCpu(3) == 1 && stats.nodeOfCpu(4) == -1, "CPU to node mapping");
+    expect(node0.mem_total_kb == 16000000 && node0.mem_free_kb == 4000000, "node 0 meminfo parsed");
+    expect(node0.mem_used_kb == 8000000 && near(node0.mem_usage_percent, 50.0), "page cache and reclaimable slab count as available");
+    expect(node1.mem_used_kb == 0 && near(node1.mem_usage_percent, 0.0), "available memory is capped at the node total");
+    expect(node0.numa_hit == 1000 && node0.numa_miss == 10 && node1.numa_foreign == 10, "numastat counters parsed");
+    expect(node0.cpu_history.empty(), "no history before the second sample");
+
+    tree.writeFile("check/devices/system/node/node0/numastat", nodeNumastat(3000, 10, 5));
+    stats.update(second_stat.data(), second_stat.size());
+    expect(near(node0.cpu_usage_percent, 75.0), "node 0 CPU usage sums all 10 columns with iowait as idle");
+    expect(near(node1.cpu_usage_percent, 100.0 / 3.0), "node 1 CPU usage counts steal as busy");
+    expect(node0.hit_per_second > 0.0 && node0.miss_per_second == 0.0, "numastat rates");
+    expect(node0.cpu_history.size() == 1 && node0.mem_history.size() == 1, "history after the second sample");
+}
+
+void buildNodeTree(const FixtureTree& tree, int nodes, int cpus_per_node) {
+    for (int node = 0; node < nodes; ++node) {
+        std::string node_dir = "devices/system/node/node" + std::to_string(node) + "/";
+        int first_cpu = node * cpus_per_node;
+        tree.writeFile(node_dir + "cpulist", std::to_string(first_cpu) + "-" + std::to_string(first_cpu + cpus_per_node - 1) + "\n");
+        tree.writeFile(node_dir + "meminfo", nodeMeminfo(node, 64000000, 20000000, 10000000, 2000000));
+        tree.writeFile(node_dir + "numastat", nodeNumastat(123456789, 12345, 6789));
+    }
+}
+
+std::string buildProcStat(int cpus, int tick) {
+    std::string text = "cpu  0 0 0 0 0 0 0 0 0 0\n";
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        uint64_t busy = static_cast<uint64_t>(1000 + tick * (cpu % 7 + 1));
+        uint64_t idle = static_cast<uint64_t>(100000 + tick * (100 - cpu % 7));
+        text += "cpu" + std::to_string(cpu) + " " + std::to_string(busy) + " 0 " + std::to_string(busy / 2) +
+                " " + std::to_string(idle) + " 0 0 0 0 0 0\n";
+    }
+    text += "intr 0\nctxt 0\n";
+    return text;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 8;
+    int cpus_per_node = 32;
+    int ticks = 200;
+
+    parseIntOptions(argc, argv, {{"--nodes", &nodes, 1}, {"--cpus-per-node", &cpus_per_node, 1}, {"--ticks", &ticks, 1}});
+
+    FixtureTree tree;
+    if (tree.root().empty()) {
+        std::cerr << "Could not create fixture directory" << std::endl;
+        return 1;
+    }
+
+    checkTwoNodes(tree);
+    if (checkFailures() > 0) {
+        std::cerr << checkFailures() << " NUMA check(s) failed" << std::endl;
+        return 1;
+    }
+
+    buildNodeTree(tree, nodes, cpus_per_node);
+    std::vector<std::string> stats_text;
+    for (int tick = 0; tick <= ticks; ++tick) {
+        stats_text.push_back(buildProcStat(nodes * cpus_per_node, tick));
+    }
+
+    NumaStats stats(tree.root(), HISTORY_POINTS);
+    stats.update(stats_text[0].data(), stats_text[0].size());
+
+    std::vector<double> tick_ms;
+    for (int tick = 1; tick <= ticks; ++tick) {
+        Clock::time_point start = Clock::now();
+        stats.update(stats_text[static_cast<size_t>(tick)].data(), stats_text[static_cast<size_t>(tick)].size());
+        tick_ms.push_back(millisecondsSince(start));
+    }
+
+    std::cout << "NUMA checks passed" << std::endl;
+    std::cout << "Synthetic tree: " << nodes << " nodes x " << cpus_per_node << " CPUs, " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  update: " << median(tick_ms) << " ms median, "
+              << *std::max_element(tick_ms.begin(), tick_ms.end()) << " ms max" << std::endl;
+    return 0;
+}
@@ -0,0 +1,137 @@
+// CPU power benchmark: times CpuPowerStats::update() on a synthetic cpufreq/cpuidle/powercap tree
+// and checks that a wrapped RAPL energy counter still yields a sane power reading, and that a zone
+// with no known range skips a drop instead of reporting it.
+// --fd-limit lowers RLIMIT_NOFILE (soft and hard) first, to exercise the open-per-read fallback.
+//
+// Usage: power_bench [--cpus N] [--states M] [--ticks T] [--fd-limit L]
+
+#include "cpu_power_stats.h"
+#include "fixture_tree.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <sys/resource.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const uint64_t PACKAGE_MAX_ENERGY_UJ = 262143328850ULL;
+// A wrapped reading within this share of the expected power passes the check.
+const double WRAP_TOLERANCE = 0.2;
+
+void buildCpuTree(const FixtureTree& tree, int cpus, int states) {
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        std::string cpu_dir = "devices/system/cpu/cpu" + std::to_string(cpu) + "/";
+        tree.writeFile(cpu_dir + "cpufreq/scaling_cur_freq", std::to_string(800000 + cpu * 10000) + "\n");
+        for (int state = 0; state < states; ++state) {
+            std::string state_dir = cpu_dir + "cpuidle/state" + std::to_string(state) + "/";
+            tree.writeFile(state_dir + "name", (state == 0 ? std::string("POLL") : "C" + std::to_string(state)) + "\n");
+            tree.writeFile(state_dir + "time", std::to_string(1000000 * (state + 1)) + "\n");
+        }
+    }
+}
+
+void buildRaplTree(const FixtureTree& tree) {
+    // psys reports no range, so a drop in its counter cannot be told apart from a reset.
+    const char* zones[][3] = {
+        {"intel-rapl:0", "package-0", "262143328850"},
+        {"intel-rapl:0:0", "core", "262143328850"},
+        {"intel-rapl:0:1", "uncore", "262143328850"},
+        {"intel-rapl:1", "psys", "0"},
+    };
+    for (const auto& zone : zones) {
+        std::string zone_dir = std::string("class/powercap/") + zone[0] + "/";
+        tree.writeFile(zone_dir + "name", std::string(zone[1]) + "\n");
+        tree.writeFile(zone_dir + "energy_uj", "1000000\n");
+        tree.writeFile(zone_dir + "max_energy_range_uj", std::string(zone[2]) + "\n");
+    }
+}
+
+size_t openDescriptorCount() {
+    return listDirectory("/proc/self/fd").size();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int cpus = 256;
+    int states = 8;
+    int ticks = 200;
+    int fd_limit = 0;
+
+    parseIntOptions(argc, argv, {{"--cpus", &cpus, 1}, {"--states", &states, 1}, {"--ticks", &ticks, 1},
+                                 {"--fd-limit", &fd_limit, 0}});
+
+    if (fd_limit > 0) {
+        rlimit limit;
+        limit.rlim_cur = static_cast<rlim_t>(fd_limit);
+        limit.rlim_max = static_cast<rlim_t>(fd_limit);
+        if (setrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            std::cerr << "Could not lower the descriptor limit to " << fd_limit << std::endl;
+            return 1;
+        }
+    }
+
+    FixtureTree tree;
+    if (tree.root().empty()) {
+        std::cerr << "Could not create fixture directory" << std::endl;
+        return 1;
+    }
+    buildCpuTree(tree, cpus, states);
+    buildRaplTree(tree);
+
+    CpuPowerStats stats(tree.root());
+    size_t descriptors_before = openDescriptorCount();
+    Clock::time_point discover_start = Clock::now();
+    stats.discover();
+    double discover_ms = millisecondsSince(discover_start);
+    size_t descriptors_held = openDescriptorCount() - descriptors_before;
+    stats.update();
+
+    std::vector<double> tick_ms;
+    for (int tick = 0; tick < ticks; ++tick) {
+        Clock::time_point start = Clock::now();
+        stats.update();
+        tick_ms.push_back(millisecondsSince(start));
+    }
+
+    // Wraparound: the package counter goes from 0.5 J below its range to 0.5 J past zero.
+    tree.writeFile("class/powercap/intel-rapl:0/energy_uj", std::to_string(PACKAGE_MAX_ENERGY_UJ - 500000) + "\n");
+    Clock::time_point wrap_start = Clock::now();
+    stats.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    tree.writeFile("class/powercap/intel-rapl:0/energy_uj", "500000\n");
+    tree.writeFile("class/powercap/intel-rapl:1/energy_uj", "500000\n");
+    stats.update();
+    double expected_watts = 1.0 / (millisecondsSince(wrap_start) / 1000.0);
+
+    size_t files = static_cast<size_t>(cpus) * (1 + static_cast<size_t>(states)) + stats.raplDomains().size();
+    std::cout << "Synthetic tree: " << cpus << " CPUs x " << states << " idle states, "
+              << stats.raplDomains().size() << " RAPL zones (" << files << " files), " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  discover: " << discover_ms << " ms, " << descriptors_held << " descriptors held" << std::endl;
+    std::cout << "  update:   " << median(tick_ms) << " ms median, "
+              << *std::max_element(tick_ms.begin(), tick_ms.end()) << " ms max" << std::endl;
+    if (stats.raplDomains().size() != 4) {
+        std::cerr << "Expected 4 RAPL zones, opened " << stats.raplDomains().size() << std::endl;
+        return 1;
+    }
+    const RaplDomain& package = stats.raplDomains()[0];
+    const RaplDomain& psys = stats.raplDomains()[3];
+    std::cout << "  wrapped " << package.name << ": " << package.watts
+              << " W (expected about " << expected_watts << " W)" << std::endl;
+    std::cout << "  dropped " << psys.name << " with no range: " << psys.watts << " W (expected 0 W)" << std::endl;
+
+    expect(package.name == "package-0" && psys.name == "psys", "RAPL zones in discovery order");
+    expect(std::abs(package.watts - expected_watts) <= expected_watts * WRAP_TOLERANCE, "wrapped counter gives the expected power");
+    expect(psys.watts == 0.0, "drop without a known range is skipped");
+    if (checkFailures() > 0) {
+        std::cerr << checkFailures() << " RAPL check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
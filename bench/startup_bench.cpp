@@ -0,0 +1,172 @@
+// Startup benchmark: compares the old blocking startup (discover every hwmon sensor and take the first
+// sample before anything can be drawn) with asynchronous discovery on a synthetic hwmon tree.
+// Nothing is drawn to a terminal: the times stop once the panel text has been formatted, first with
+// placeholders and then with the first real sample. CPU usage is a delta between two /proc/stat reads,
+// so that sample is taken one interval after SystemData is constructed. Sensor discovery is reported
+// on its own line.
+//
+// Usage: startup_bench [--chips N] [--sensors M] [--runs R] [--interval-ms I]
+
+#include "system_data.h"
+#include "fixture_tree.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+#include <cstdio>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void buildHwmonTree(const FixtureTree& tree, int chips, int sensors_per_chip) {
+    for (int chip = 0; chip < chips; ++chip) {
+        std::string chip_dir = "class/hwmon/hwmon" + std::to_string(chip) + "/";
+        tree.writeFile(chip_dir + "name", "chip" + std::to_string(chip) + "\n");
+        for (int sensor = 1; sensor <= sensors_per_chip; ++sensor) {
+            std::string prefix = chip_dir + "temp" + std::to_string(sensor);
+            tree.writeFile(prefix + "_input", std::to_string(30000 + sensor * 500) + "\n");
+            tree.writeFile(prefix + "_label", "Chip " + std::to_string(chip) + " Sensor " + std::to_string(sensor) + "\n");
+        }
+    }
+}
+
+struct FirstSample {
+    double cpu_usage;
+    MemoryInfo memory;
+    DiskInfo disk;
+};
+
+// The reference /proc/stat read happens in SystemData's constructor; the first usable CPU value is the
+// one read an interval later.
+FirstSample takeFirstSample(SystemData& data, int interval_ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    FirstSample sample;
+    sample.cpu_usage = data.getCpuUsage();
+    sample.memory = data.getMemoryInfo();
+    sample.disk = data.getDiskUsage("/");
+    return sample;
+}
+
+// The panel text the terminal UI draws, formatted into a string. With no sample yet every value is a
+// placeholder.
+std::string formatPanels(const FirstSample* sample, size_t sensor_count) {
+    char buf[160];
+    std::string frame = "System Monitor\n";
+    if (sample) {
+        std::snprintf(buf, sizeof(buf), "CPU Usage\n  Current Usage: %.1f %%\n", sample->cpu_usage);
+        frame += buf;
+        std::snprintf(buf, sizeof(buf), "Memory (RAM)\n  Total: %.2f GB\n  Usage: %.1f %%\n",
+                      static_cast<double>(sample->memory.total_kb) / (1024.0 * 1024.0), sample->memory.usage_percent);
+        frame += buf;
+        std::snprintf(buf, sizeof(buf), "Disk Usage (Root '/')\n  Total: %ld GB\n  Usage: %.1f %%\n",
+                      sample->disk.total_space_gb, sample->disk.usage_percent);
+        frame += buf;
+    } else {
+        frame += "CPU Usage\n  Current Usage: N/A\nMemory (RAM)\n  N/A\nDisk Usage (Root '/')\n  N/A\n";
+    }
+    std::snprintf(buf, sizeof(buf), "Temperature (CPU/GPU/Other)\n  %zu sensors\n", sensor_count);
+    frame += sensor_count > 0 ? buf : "Temperature (CPU/GPU/Other)\n  Discovering sensors...\n";
+    return frame;
+}
+
+struct AsyncResult {
+    double placeholders_ms;
+    double first_sample_ms;
+    double first_sensors_ms;
+    double discovery_done_ms;
+};
+
+double runBlocking(const std::string& root, int interval_ms) {
+    Clock::time_point start = Clock::now();
+    SystemData data(root);
+    data.discoverSensors();
+    size_t sensor_count = data.getAllTemperatures().size();
+    FirstSample sample = takeFirstSample(data, interval_ms);
+    formatPanels(&sample, sensor_count);
+    return millisecondsSince(start);
+}
+
+// Mirrors the terminal UI's startup: spawn discovery, format placeholders, then take the first
+// sample and format it. Sensor batches arrive on the worker thread in the meantime.
+AsyncResult runAsync(const std::string& root, int interval_ms) {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool have_first_sensors = false;
+    bool done = false;
+    AsyncResult result = {0.0, 0.0, 0.0, 0.0};
+
+    Clock::time_point start = Clock::now();
+    SystemData data(root);
+    data.startSensorDiscovery([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!have_first_sensors) {
+            result.first_sensors_ms = millisecondsSince(start);
+            have_first_sensors = true;
+        }
+        if (data.isSensorDiscoveryDone() && !done) {
+            result.discovery_done_ms = millisecondsSince(start);
+            done = true;
+            done_cv.notify_all();
+        }
+    });
+
+    std::string placeholders = formatPanels(nullptr, 0);
+    result.placeholders_ms = millisecondsSince(start);
+
+    FirstSample sample = takeFirstSample(data, interval_ms);
+    std::string first_sample = formatPanels(&sample, data.takeDiscoveredSensors().size());
+    result.first_sample_ms = millisecondsSince(start);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [&]() { return done; });
+    lock.unlock();
+    data.takeDiscoveredSensors();
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int chips = 64;
+    int sensors_per_chip = 16;
+    int runs = 9;
+    int interval_ms = 1000;
+
+    parseIntOptions(argc, argv, {{"--chips", &chips, 0}, {"--sensors", &sensors_per_chip, 0}, {"--runs", &runs, 1},
+                                 {"--interval-ms", &interval_ms, 20}});
+
+    FixtureTree tree;
+    if (tree.root().empty()) {
+        std::cerr << "Could not create fixture directory" << std::endl;
+        return 1;
+    }
+    buildHwmonTree(tree, chips, sensors_per_chip);
+
+    std::vector<double> blocking_ms;
+    std::vector<double> placeholders_ms;
+    std::vector<double> first_sample_ms;
+    std::vector<double> first_sensors_ms;
+    std::vector<double> discovery_done_ms;
+    for (int run = 0; run < runs; ++run) {
+        blocking_ms.push_back(runBlocking(tree.root(), interval_ms));
+        AsyncResult async_result = runAsync(tree.root(), interval_ms);
+        placeholders_ms.push_back(async_result.placeholders_ms);
+        first_sample_ms.push_back(async_result.first_sample_ms);
+        first_sensors_ms.push_back(async_result.first_sensors_ms);
+        discovery_done_ms.push_back(async_result.discovery_done_ms);
+    }
+
+    std::cout << "Synthetic hwmon tree: " << chips << " chips x " << sensors_per_chip << " sensors, "
+              << runs << " runs (median), first sample after " << interval_ms << " ms" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  blocking startup  placeholders formatted: " << median(blocking_ms) << " ms"
+              << "  first sample formatted: " << median(blocking_ms) << " ms" << std::endl;
+    std::cout << "  async startup     placeholders formatted: " << median(placeholders_ms) << " ms"
+              << "  first sample formatted: " << median(first_sample_ms) << " ms" << std::endl;
+    std::cout << "  async discovery   first sensors: " << median(first_sensors_ms) << " ms"
+              << "  all sensors: " << median(discovery_done_ms) << " ms" << std::endl;
+    return 0;
+}
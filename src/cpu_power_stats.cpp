@@ -0,0 +1,216 @@
+#include "cpu_power_stats.h"
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <cstdlib>
+#include <sys/resource.h>
+
+namespace {
+
+// Upper bound on idle-state files read per update(): 32 cores with 8 states each. Smaller machines are
+// read in full every time; on larger ones each core's residency covers several update intervals.
+// Opening a file for every read costs several times a pread(), so that fallback reads fewer per update.
+const size_t IDLE_FILES_PER_UPDATE = 256;
+const size_t IDLE_PATHS_PER_UPDATE = 128;
+
+// The idle-state files are kept open only if they use at most this share of the descriptor limit,
+// so hwmon, IRQ, NUMA and socket descriptors never fail with EMFILE because of them.
+const rlim_t IDLE_FILES_LIMIT_DIVISOR = 4;
+
+}
+
+CpuPowerStats::CpuPowerStats(const std::string& sysfs_root)
+    : sysfs_root_(sysfs_root), discovered_(false), idle_cpus_per_update_(0), next_idle_cpu_(0),
+      has_previous_(false) {}
+
+void CpuPowerStats::discover() {
+    cpu_ids_.clear();
+    frequency_files_.clear();
+    idle_state_names_.clear();
+    idle_time_paths_.clear();
+    idle_time_files_.clear();
+    rapl_counters_.clear();
+    rapl_domains_.clear();
+
+    // The few RAPL counters are opened before the per-core files so they always get a descriptor.
+    discoverRapl();
+    discoverCpus();
+    openIdleFiles();
+
+    frequencies_mhz_.assign(cpu_ids_.size(), -1.0);
+    prev_idle_time_us_.assign(idle_time_paths_.size(), 0);
+    idle_residency_percent_.assign(idle_time_paths_.size(), 0.0);
+    idle_sample_times_.assign(cpu_ids_.size(), std::chrono::steady_clock::time_point());
+    has_idle_sample_.assign(cpu_ids_.size(), false);
+    size_t state_count = std::max<size_t>(1, idle_state_names_.size());
+    size_t files_per_update = idle_time_files_.empty() ? IDLE_PATHS_PER_UPDATE : IDLE_FILES_PER_UPDATE;
+    idle_cpus_per_update_ = std::max<size_t>(1, files_per_update / state_count);
+    next_idle_cpu_ = 0;
+    has_previous_ = false;
+    discovered_ = true;
+}
+
+void CpuPowerStats::discoverCpus() {
+    std::string cpu_path = sysfs_root_ + "/devices/system/cpu/";
+    for (const std::string& name : listDirectory(cpu_path)) {
+        int cpu_id;
+        if (parseIndexedName(name, "cpu", cpu_id)) cpu_ids_.push_back(cpu_id);
+    }
+    std::sort(cpu_ids_.begin(), cpu_ids_.end());
+
+    std::vector<std::vector<std::string>> idle_paths_per_cpu(cpu_ids_.size());
+    for (size_t i = 0; i < cpu_ids_.size(); ++i) {
+        std::string cpu_dir = cpu_path + "cpu" + std::to_string(cpu_ids_[i]) + "/";
+        frequency_files_.emplace_back(cpu_dir + "cpufreq/scaling_cur_freq");
+
+        for (size_t state = 0;; ++state) {
+            std::string state_dir = cpu_dir + "cpuidle/state" + std::to_string(state) + "/";
+            std::string state_name;
+            if (!readFirstLine(state_dir + "name", state_name)) break;
+            if (state >= idle_state_names_.size()) idle_state_names_.push_back(state_name);
+            idle_paths_per_cpu[i].push_back(state_dir + "time");
+        }
+    }
+
+    size_t state_count = idle_state_names_.size();
+    idle_time_paths_.resize(cpu_ids_.size() * state_count);
+    for (size_t i = 0; i < cpu_ids_.size(); ++i) {
+        for (size_t state = 0; state < idle_paths_per_cpu[i].size(); ++state) {
+            idle_time_paths_[i * state_count + state] = std::move(idle_paths_per_cpu[i][state]);
+        }
+    }
+}
+
+void CpuPowerStats::openIdleFiles() {
+    // The limit itself is left to main(); it only decides whether the files can stay open.
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+    if (limit.rlim_cur != RLIM_INFINITY && idle_time_paths_.size() > limit.rlim_cur / IDLE_FILES_LIMIT_DIVISOR) {
+        // Too many to keep open: update() opens each file for the duration of its read instead.
+        return;
+    }
+
+    idle_time_files_.reserve(idle_time_paths_.size());
+    for (const std::string& path : idle_time_paths_) {
+        idle_time_files_.push_back(path.empty() ? SysfsFile() : SysfsFile(path));
+    }
+}
+
+void CpuPowerStats::discoverRapl() {
+    std::string powercap_path = sysfs_root_ + "/class/powercap/";
+    std::vector<std::string> zones;
+    for (const std::string& name : listDirectory(powercap_path)) {
+        if (name.rfind("intel-rapl:", 0) == 0) zones.push_back(name);
+    }
+    std::sort(zones.begin(), zones.end());
+
+    std::map<std::string, std::string> zone_names;
+    bool reported_unreadable = false;
+    for (const std::string& zone : zones) {
+        std::string zone_dir = powercap_path + zone + "/";
+        std::string name;
+        if (!readFirstLine(zone_dir + "name", name)) name = zone;
+        zone_names[zone] = name;
+
+        // Subzones (intel-rapl:0:1) are reported under their package, e.g. "package-0/core".
+        size_t last_colon = zone.rfind(':');
+        if (last_colon != zone.find(':')) {
+            auto parent = zone_names.find(zone.substr(0, last_colon));
+            if (parent != zone_names.end()) name = parent->second + "/" + name;
+        }
+
+        RaplCounter counter;
+        counter.energy_file = SysfsFile(zone_dir + "energy_uj");
+        if (!counter.energy_file.isOpen()) {
+            if (!reported_unreadable) {
+                std::cerr << "RAPL energy counters in " << powercap_path << " are not readable (root is usually required)" << std::endl;
+                reported_unreadable = true;
+            }
+            continue;
+        }
+        std::string max_range;
+        counter.max_energy_range_uj = readFirstLine(zone_dir + "max_energy_range_uj", max_range) ? std::strtoull(max_range.c_str(), nullptr, 10) : 0;
+        counter.prev_energy_uj = 0;
+        counter.has_previous = false;
+        rapl_counters_.push_back(std::move(counter));
+        rapl_domains_.push_back({name, 0.0});
+    }
+}
+
+void CpuPowerStats::update() {
+    if (!discovered_) {
+        discover();
+    }
+
+    std::chrono::steady_clock::time_point current_time = std::chrono::steady_clock::now();
+    double elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(current_time - last_update_time_).count();
+    bool have_interval = has_previous_ && elapsed_seconds > 0.0;
+
+    for (size_t i = 0; i < frequency_files_.size(); ++i) {
+        uint64_t khz;
+        frequencies_mhz_[i] = frequency_files_[i].readInteger(khz) ? static_cast<double>(khz) / 1000.0 : -1.0;
+    }
+
+    size_t idle_cpus = std::min(idle_cpus_per_update_, cpu_ids_.size());
+    for (size_t n = 0; n < idle_cpus && !idle_state_names_.empty(); ++n) {
+        updateIdleResidency(next_idle_cpu_, current_time);
+        next_idle_cpu_ = (next_idle_cpu_ + 1) % cpu_ids_.size();
+    }
+
+    for (size_t i = 0; i < rapl_counters_.size(); ++i) {
+        RaplCounter& counter = rapl_counters_[i];
+        uint64_t energy_uj;
+        if (!counter.energy_file.readInteger(energy_uj)) continue;
+        if (counter.has_previous && have_interval) {
+            // The counter wraps at max_energy_range_uj. A drop without a known range, or a delta larger
+            // than the range (the counter was reset rather than wrapped), gives no usable interval.
+            bool wrapped = energy_uj < counter.prev_energy_uj;
+            uint64_t delta = wrapped ? energy_uj + counter.max_energy_range_uj - counter.prev_energy_uj
+                                     : energy_uj - counter.prev_energy_uj;
+            bool range_known = counter.max_energy_range_uj > 0;
+            if ((range_known || !wrapped) && (!range_known || delta <= counter.max_energy_range_uj)) {
+                rapl_domains_[i].watts = static_cast<double>(delta) / 1e6 / elapsed_seconds;
+            }
+        }
+        counter.prev_energy_uj = energy_uj;
+        counter.has_previous = true;
+    }
+
+    last_update_time_ = current_time;
+    has_previous_ = true;
+}
+
+void CpuPowerStats::updateIdleResidency(size_t cpu_index, std::chrono::steady_clock::time_point now) {
+    double elapsed_us = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(now - idle_sample_times_[cpu_index]).count();
+    bool have_interval = has_idle_sample_[cpu_index] && elapsed_us > 0.0;
+
+    size_t state_count = idle_state_names_.size();
+    for (size_t i = cpu_index * state_count; i < (cpu_index + 1) * state_count; ++i) {
+        if (idle_time_paths_[i].empty()) continue;
+        uint64_t time_us;
+        bool read = idle_time_files_.empty() ? SysfsFile(idle_time_paths_[i]).readInteger(time_us)
+                                             : idle_time_files_[i].readInteger(time_us);
+        if (!read) continue;
+        if (have_interval && time_us >= prev_idle_time_us_[i]) {
+            double residency = static_cast<double>(time_us - prev_idle_time_us_[i]) / elapsed_us * 100.0;
+            idle_residency_percent_[i] = std::min(100.0, residency);
+        }
+        prev_idle_time_us_[i] = time_us;
+    }
+    idle_sample_times_[cpu_index] = now;
+    has_idle_sample_[cpu_index] = true;
+}
+
+double CpuPowerStats::idleResidencyPercent(size_t cpu_index, size_t state) const {
+    size_t index = cpu_index * idle_state_names_.size() + state;
+    return index < idle_residency_percent_.size() ? idle_residency_percent_[index] : 0.0;
+}
+
+double CpuPowerStats::averageIdleResidencyPercent(size_t state) const {
+    if (cpu_ids_.empty() || state >= idle_state_names_.size()) return 0.0;
+    double total = 0.0;
+    for (size_t i = 0; i < cpu_ids_.size(); ++i) {
+        total += idleResidencyPercent(i, state);
+    }
+    return total / static_cast<double>(cpu_ids_.size());
+}
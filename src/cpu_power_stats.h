@@ -0,0 +1,77 @@
+#ifndef CPU_POWER_STATS_H
+#define CPU_POWER_STATS_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "sysfs_file.h"
+
+struct RaplDomain {
+    std::string name;
+    double watts;
+};
+
+// Per-core frequency (cpufreq), idle-state residency (cpuidle) and RAPL energy (powercap) collectors.
+// Frequency and energy files are opened by discover() and read with one pread() per update(). There is
+// one idle-state file per core and state, so update() reads only a slice of the cores each time, and
+// those files are kept open only when the descriptor limit has room for them.
+class CpuPowerStats {
+public:
+    explicit CpuPowerStats(const std::string& sysfs_root);
+
+    void discover();
+    bool isDiscovered() const { return discovered_; }
+    void update();
+
+    const std::vector<int>& cpuIds() const { return cpu_ids_; }
+    // MHz per entry of cpuIds(), or -1.0 when the core has no cpufreq policy.
+    const std::vector<double>& frequenciesMhz() const { return frequencies_mhz_; }
+
+    const std::vector<std::string>& idleStateNames() const { return idle_state_names_; }
+    // Share of the core's last sampling interval spent in the given idle state, in percent.
+    double idleResidencyPercent(size_t cpu_index, size_t state) const;
+    double averageIdleResidencyPercent(size_t state) const;
+
+    const std::vector<RaplDomain>& raplDomains() const { return rapl_domains_; }
+
+private:
+    struct RaplCounter {
+        SysfsFile energy_file;
+        uint64_t max_energy_range_uj;
+        uint64_t prev_energy_uj;
+        bool has_previous;
+    };
+
+    std::string sysfs_root_;
+    bool discovered_;
+
+    std::vector<int> cpu_ids_;
+    std::vector<SysfsFile> frequency_files_;
+    std::vector<double> frequencies_mhz_;
+
+    // Row-major cpu x state matrices; states a core does not expose have an empty path and read as zero.
+    std::vector<std::string> idle_state_names_;
+    std::vector<std::string> idle_time_paths_;
+    std::vector<SysfsFile> idle_time_files_;
+    std::vector<uint64_t> prev_idle_time_us_;
+    std::vector<double> idle_residency_percent_;
+    // Per core: when its idle states were last read. Cores are sampled round-robin from next_idle_cpu_.
+    std::vector<std::chrono::steady_clock::time_point> idle_sample_times_;
+    std::vector<bool> has_idle_sample_;
+    size_t idle_cpus_per_update_;
+    size_t next_idle_cpu_;
+
+    std::vector<RaplCounter> rapl_counters_;
+    std::vector<RaplDomain> rapl_domains_;
+
+    std::chrono::steady_clock::time_point last_update_time_;
+    bool has_previous_;
+
+    void discoverCpus();
+    void discoverRapl();
+    void openIdleFiles();
+    void updateIdleResidency(size_t cpu_index, std::chrono::steady_clock::time_point now);
+};
+
+#endif
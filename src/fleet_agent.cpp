@@ -0,0 +1,213 @@
+#include "fleet_agent.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <algorithm>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Past this much unsent data the aggregator is not keeping up: queued frames are dropped and the
+// stream restarts from a keyframe instead of buffering without bound.
+const size_t MAX_PENDING_BYTES = 256 * 1024;
+const size_t COMPACT_THRESHOLD_BYTES = 64 * 1024;
+const int MIN_RECONNECT_DELAY_MS = 500;
+const int MAX_RECONNECT_DELAY_MS = 10000;
+// An unreachable aggregator must not hold up sampling for the kernel's SYN retry timeout.
+const int CONNECT_TIMEOUT_MS = 1000;
+
+int64_t wallClockMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int millisecondsUntil(std::chrono::steady_clock::time_point deadline) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return static_cast<int>(std::max<long long>(0, remaining));
+}
+
+}
+
+FleetAgent::FleetAgent(SystemData& sys_data, const StreamEndpoint& endpoint, const std::string& hostname,
+                       int interval_ms, int batch_size)
+    : sysdata(sys_data), endpoint_(endpoint), hostname_(hostname),
+      interval_ms_(std::max(1, interval_ms)), batch_size_(std::max(1, batch_size)),
+      fd_(-1), sequence_(0), sent_(0), frames_in_batch_(0), frames_sent_(0), frames_dropped_(0) {}
+
+FleetAgent::~FleetAgent() {
+    disconnect();
+}
+
+void FleetAgent::run(const std::atomic<bool>& stop_requested) {
+    sysdata.discoverSensors();
+
+    std::chrono::steady_clock::time_point next_sample = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point next_connect = next_sample;
+    int reconnect_delay_ms = MIN_RECONNECT_DELAY_MS;
+
+    while (!stop_requested) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        // The loop blocks in poll() below between samples, and in connectStreamEndpoint() for at most
+        // one interval (capped at CONNECT_TIMEOUT_MS) while connecting; SIGINT interrupts both.
+        if (fd_ < 0 && now >= next_connect) {
+            if (connectToAggregator()) {
+                reconnect_delay_ms = MIN_RECONNECT_DELAY_MS;
+            } else {
+                next_connect = now + std::chrono::milliseconds(reconnect_delay_ms);
+                reconnect_delay_ms = std::min(MAX_RECONNECT_DELAY_MS, reconnect_delay_ms * 2);
+            }
+        }
+
+        if (now >= next_sample) {
+            // Sampling continues while disconnected so CPU deltas stay short once the link is back.
+            HostSnapshot snapshot = capture();
+            if (fd_ >= 0) {
+                enqueue(snapshot);
+            }
+            next_sample += std::chrono::milliseconds(interval_ms_);
+            if (next_sample < now) {
+                next_sample = now + std::chrono::milliseconds(interval_ms_);
+            }
+        }
+
+        bool want_flush = fd_ >= 0 && frames_in_batch_ >= batch_size_;
+        if (want_flush && !flush()) {
+            disconnect();
+            next_connect = std::chrono::steady_clock::now() + std::chrono::milliseconds(reconnect_delay_ms);
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point wake = next_sample;
+        if (fd_ < 0 && next_connect < wake) {
+            wake = next_connect;
+        }
+
+        pollfd pfd = {fd_, 0, 0};
+        if (fd_ >= 0 && want_flush && sent_ < pending_.size()) {
+            pfd.events = POLLOUT;
+        }
+        int ready = poll(fd_ >= 0 ? &pfd : nullptr, fd_ >= 0 ? 1 : 0, millisecondsUntil(wake));
+        if (ready > 0 && (pfd.revents & (POLLERR | POLLHUP))) {
+            std::cerr << "Connection to " << endpoint_.describe() << " lost" << std::endl;
+            disconnect();
+            next_connect = std::chrono::steady_clock::now() + std::chrono::milliseconds(reconnect_delay_ms);
+        }
+    }
+
+    if (fd_ >= 0) {
+        flush();
+    }
+}
+
+HostSnapshot FleetAgent::capture() {
+    HostSnapshot snapshot;
+    snapshot.sequence = sequence_++;
+    snapshot.fields[FIELD_TIMESTAMP_MS] = wallClockMilliseconds();
+    snapshot.fields[FIELD_CPU_PERMILLE] = std::lround(sysdata.getCpuUsage() * 10.0);
+
+    MemoryInfo mem_info = sysdata.getMemoryInfo();
+    snapshot.fields[FIELD_MEM_TOTAL_KB] = mem_info.total_kb;
+    snapshot.fields[FIELD_MEM_USED_KB] = mem_info.used_kb;
+    snapshot.fields[FIELD_MEM_AVAILABLE_KB] = mem_info.available_kb;
+
+    DiskInfo disk_info = sysdata.getDiskUsage("/");
+    snapshot.fields[FIELD_DISK_TOTAL_GB] = disk_info.total_space_gb;
+    snapshot.fields[FIELD_DISK_USED_GB] = disk_info.used_space_gb;
+
+    for (const auto& pair : sysdata.getAllTemperatures()) {
+        snapshot.sensor_names.push_back(pair.first);
+        snapshot.temperatures_centi.push_back(std::lround(pair.second * 100.0));
+    }
+    return snapshot;
+}
+
+bool FleetAgent::connectToAggregator() {
+    fd_ = connectStreamEndpoint(endpoint_, std::min(CONNECT_TIMEOUT_MS, interval_ms_));
+    if (fd_ < 0) {
+        return false;
+    }
+    std::cerr << "Streaming to " << endpoint_.describe() << " as " << hostname_ << std::endl;
+    encoder_.requestKeyframe();
+    return true;
+}
+
+void FleetAgent::disconnect() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    pending_.clear();
+    frame_ends_.clear();
+    sent_ = 0;
+    frames_in_batch_ = 0;
+}
+
+void FleetAgent::enqueue(const HostSnapshot& snapshot) {
+    encoder_.encode(snapshot, hostname_, pending_);
+    frame_ends_.push_back(pending_.size());
+    ++frames_in_batch_;
+
+    if (pending_.size() - sent_ > MAX_PENDING_BYTES) {
+        dropUnsentFrames();
+    }
+}
+
+void FleetAgent::dropUnsentFrames() {
+    // The frame currently on the wire (if any) must be completed to keep the stream aligned;
+    // everything queued after it is discarded and the next frame will be a keyframe.
+    size_t keep = sent_;
+    size_t frame_start = 0;
+    for (size_t frame_end : frame_ends_) {
+        if (frame_end > sent_) {
+            if (frame_start < sent_) keep = frame_end;
+            break;
+        }
+        frame_start = frame_end;
+    }
+
+    while (!frame_ends_.empty() && frame_ends_.back() > keep) {
+        frame_ends_.pop_back();
+        ++frames_dropped_;
+    }
+    pending_.resize(keep);
+    // A partially sent frame still has to go out, so keep flushing until it has.
+    frames_in_batch_ = keep > sent_ ? batch_size_ : 0;
+    encoder_.requestKeyframe();
+    std::cerr << "Aggregator is not keeping up; dropped queued frames (" << frames_dropped_ << " total)" << std::endl;
+}
+
+bool FleetAgent::flush() {
+    // One send() per batch: everything queued goes to the kernel in a single call when possible.
+    while (sent_ < pending_.size()) {
+        ssize_t n = send(fd_, pending_.data() + sent_, pending_.size() - sent_, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            std::cerr << "Error sending to " << endpoint_.describe() << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        sent_ += static_cast<size_t>(n);
+    }
+
+    while (!frame_ends_.empty() && frame_ends_.front() <= sent_) {
+        frame_ends_.pop_front();
+        ++frames_sent_;
+    }
+
+    if (sent_ == pending_.size()) {
+        pending_.clear();
+        sent_ = 0;
+        frames_in_batch_ = 0;
+    } else if (sent_ >= COMPACT_THRESHOLD_BYTES) {
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(sent_));
+        for (size_t& frame_end : frame_ends_) {
+            frame_end -= sent_;
+        }
+        sent_ = 0;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef FLEET_AGENT_H
+#define FLEET_AGENT_H
+
+#include "system_data.h"
+#include "snapshot_stream.h"
+#include "stream_endpoint.h"
+#include <atomic>
+#include <deque>
+
+// Headless mode: samples SystemData on a fixed interval and streams delta-encoded snapshots to an aggregator.
+class FleetAgent {
+public:
+    FleetAgent(SystemData& sys_data, const StreamEndpoint& endpoint, const std::string& hostname,
+               int interval_ms, int batch_size);
+    ~FleetAgent();
+
+    FleetAgent(const FleetAgent&) = delete;
+    FleetAgent& operator=(const FleetAgent&) = delete;
+
+    // Runs until stop_requested becomes true (typically set from a signal handler).
+    void run(const std::atomic<bool>& stop_requested);
+
+    uint64_t framesSent() const { return frames_sent_; }
+    uint64_t framesDropped() const { return frames_dropped_; }
+
+private:
+    SystemData& sysdata;
+    StreamEndpoint endpoint_;
+    std::string hostname_;
+    int interval_ms_;
+    int batch_size_;
+
+    int fd_;
+    SnapshotEncoder encoder_;
+    uint64_t sequence_;
+
+    // Encoded frames waiting for the socket. frame_ends_ holds the end offset of every frame in
+    // pending_, and sent_ is how much of pending_ the kernel has already accepted.
+    std::vector<uint8_t> pending_;
+    std::deque<size_t> frame_ends_;
+    size_t sent_;
+    int frames_in_batch_;
+
+    uint64_t frames_sent_;
+    uint64_t frames_dropped_;
+
+    HostSnapshot capture();
+    bool connectToAggregator();
+    void disconnect();
+    void enqueue(const HostSnapshot& snapshot);
+    bool flush();
+    void dropUnsentFrames();
+};
+
+#endif
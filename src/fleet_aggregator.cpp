@@ -0,0 +1,233 @@
+#include "fleet_aggregator.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_BUFFER_SIZE = 64 * 1024;
+const int MAX_EVENTS_PER_WAIT = 256;
+
+std::string describePeer(const sockaddr_storage& address) {
+    char host[INET6_ADDRSTRLEN] = "";
+    if (address.ss_family == AF_INET) {
+        const sockaddr_in* in = reinterpret_cast<const sockaddr_in*>(&address);
+        inet_ntop(AF_INET, &in->sin_addr, host, sizeof(host));
+        return std::string(host) + ":" + std::to_string(ntohs(in->sin_port));
+    }
+    if (address.ss_family == AF_INET6) {
+        const sockaddr_in6* in6 = reinterpret_cast<const sockaddr_in6*>(&address);
+        inet_ntop(AF_INET6, &in6->sin6_addr, host, sizeof(host));
+        return "[" + std::string(host) + "]:" + std::to_string(ntohs(in6->sin6_port));
+    }
+    return "local";
+}
+
+}
+
+double FleetHost::cpuPercent() const {
+    return static_cast<double>(snapshot.fields[FIELD_CPU_PERMILLE]) / 10.0;
+}
+
+double FleetHost::memoryPercent() const {
+    int64_t total = snapshot.fields[FIELD_MEM_TOTAL_KB];
+    if (total <= 0) return 0.0;
+    return static_cast<double>(snapshot.fields[FIELD_MEM_USED_KB]) / total * 100.0;
+}
+
+double FleetHost::diskPercent() const {
+    int64_t total = snapshot.fields[FIELD_DISK_TOTAL_GB];
+    if (total <= 0) return 0.0;
+    return static_cast<double>(snapshot.fields[FIELD_DISK_USED_GB]) / total * 100.0;
+}
+
+double FleetHost::maxTemperature() const {
+    double max_temp = -1.0;
+    for (int64_t centi : snapshot.temperatures_centi) {
+        if (centi == -100) continue;
+        max_temp = std::max(max_temp, static_cast<double>(centi) / 100.0);
+    }
+    return max_temp;
+}
+
+FleetAggregator::FleetAggregator(const StreamEndpoint& endpoint)
+    : endpoint_(endpoint), listen_fd_(-1), epoll_fd_(-1), read_buffer_(READ_BUFFER_SIZE), frames_received_(0) {}
+
+FleetAggregator::~FleetAggregator() {
+    for (auto& pair : connections_) {
+        close(pair.first);
+    }
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        if (endpoint_.kind == StreamEndpoint::UNIX) {
+            unlink(endpoint_.path.c_str());
+        }
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+    }
+}
+
+bool FleetAggregator::start() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        std::cerr << "Error creating epoll instance: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    listen_fd_ = listenStreamEndpoint(endpoint_);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event) != 0) {
+        std::cerr << "Error registering listener: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void FleetAggregator::poll(int timeout_ms) {
+    epoll_event events[MAX_EVENTS_PER_WAIT];
+    int count = epoll_wait(epoll_fd_, events, MAX_EVENTS_PER_WAIT, timeout_ms);
+    if (count < 0) {
+        if (errno != EINTR) {
+            std::cerr << "Error waiting for events: " << strerror(errno) << std::endl;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int fd = events[i].data.fd;
+        if (fd == listen_fd_) {
+            acceptConnections();
+            continue;
+        }
+        auto it = connections_.find(fd);
+        if (it == connections_.end()) continue;
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            readConnection(*it->second);
+        }
+    }
+}
+
+void FleetAggregator::acceptConnections() {
+    while (true) {
+        sockaddr_storage address;
+        socklen_t address_length = sizeof(address);
+        int fd = accept4(listen_fd_, reinterpret_cast<sockaddr*>(&address), &address_length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Error accepting connection: " << strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            std::cerr << "Error registering connection: " << strerror(errno) << std::endl;
+            close(fd);
+            continue;
+        }
+
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->peer = describePeer(address);
+        connections_[fd] = std::move(connection);
+    }
+}
+
+void FleetAggregator::readConnection(Connection& connection) {
+    // Drain the socket: with batched agents several frames usually arrive in one read.
+    while (true) {
+        ssize_t n = recv(connection.fd, read_buffer_.data(), read_buffer_.size(), 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            closeConnection(connection.fd);
+            return;
+        }
+        if (n == 0) {
+            closeConnection(connection.fd);
+            return;
+        }
+
+        int applied = connection.decoder.feed(read_buffer_.data(), static_cast<size_t>(n),
+            [this, &connection](const HostSnapshot& snapshot) {
+                if (!connection.host || connection.host->hostname != connection.decoder.hostname()) {
+                    if (connection.host) --connection.host->connections;
+                    FleetHost& host = hosts_[connection.decoder.hostname()];
+                    host.hostname = connection.decoder.hostname();
+                    ++host.connections;
+                    connection.host = &host;
+                }
+                FleetHost& host = *connection.host;
+                host.peer = connection.peer;
+                host.snapshot = snapshot;
+                host.last_update = std::chrono::steady_clock::now();
+                ++host.frames_received;
+                host.cpu_history.push_back(host.cpuPercent());
+                if (host.cpu_history.size() > MAX_HISTORY_POINTS) {
+                    host.cpu_history.pop_front();
+                }
+            });
+        if (applied < 0) {
+            std::cerr << "Malformed frame from " << connection.peer << ", closing connection" << std::endl;
+            closeConnection(connection.fd);
+            return;
+        }
+        frames_received_ += static_cast<uint64_t>(applied);
+    }
+}
+
+void FleetAggregator::closeConnection(int fd) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) return;
+    if (it->second->host) {
+        --it->second->host->connections;
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(it);
+}
+
+std::vector<const FleetHost*> FleetAggregator::sortedHosts(FleetSortKey key) const {
+    std::vector<const FleetHost*> hosts;
+    hosts.reserve(hosts_.size());
+    for (const auto& pair : hosts_) {
+        hosts.push_back(&pair.second);
+    }
+
+    auto metric = [key](const FleetHost* host) {
+        switch (key) {
+            case SORT_BY_TEMPERATURE: return host->maxTemperature();
+            case SORT_BY_MEMORY: return host->memoryPercent();
+            case SORT_BY_CPU:
+            default: return host->cpuPercent();
+        }
+    };
+    std::stable_sort(hosts.begin(), hosts.end(), [&metric](const FleetHost* a, const FleetHost* b) {
+        return metric(a) > metric(b);
+    });
+    return hosts;
+}
+
+const FleetHost* FleetAggregator::findHost(const std::string& hostname) const {
+    auto it = hosts_.find(hostname);
+    return it == hosts_.end() ? nullptr : &it->second;
+}
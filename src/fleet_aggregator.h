@@ -0,0 +1,74 @@
+#ifndef FLEET_AGGREGATOR_H
+#define FLEET_AGGREGATOR_H
+
+#include "snapshot_stream.h"
+#include "stream_endpoint.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <deque>
+#include <chrono>
+
+enum FleetSortKey { SORT_BY_CPU, SORT_BY_TEMPERATURE, SORT_BY_MEMORY };
+
+struct FleetHost {
+    std::string hostname;
+    std::string peer;
+    HostSnapshot snapshot;
+    std::deque<double> cpu_history;
+    std::chrono::steady_clock::time_point last_update;
+    int connections = 0;
+    uint64_t frames_received = 0;
+
+    double cpuPercent() const;
+    double memoryPercent() const;
+    double diskPercent() const;
+    // Highest readable temperature in degrees Celsius, or -1.0 when the host reports none.
+    double maxTemperature() const;
+};
+
+// Accepts agent connections on one endpoint and keeps the latest snapshot of every host.
+// Single-threaded: poll() drives accept, reads and decoding through one epoll set.
+class FleetAggregator {
+public:
+    explicit FleetAggregator(const StreamEndpoint& endpoint);
+    ~FleetAggregator();
+
+    FleetAggregator(const FleetAggregator&) = delete;
+    FleetAggregator& operator=(const FleetAggregator&) = delete;
+
+    bool start();
+    void poll(int timeout_ms);
+
+    std::vector<const FleetHost*> sortedHosts(FleetSortKey key) const;
+    const FleetHost* findHost(const std::string& hostname) const;
+
+    size_t connectionCount() const { return connections_.size(); }
+    uint64_t framesReceived() const { return frames_received_; }
+    size_t getMaxHistoryPoints() const { return MAX_HISTORY_POINTS; }
+
+private:
+    struct Connection {
+        int fd;
+        std::string peer;
+        SnapshotDecoder decoder;
+        FleetHost* host = nullptr;
+    };
+
+    StreamEndpoint endpoint_;
+    int listen_fd_;
+    int epoll_fd_;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+    std::map<std::string, FleetHost> hosts_;
+    std::vector<uint8_t> read_buffer_;
+    uint64_t frames_received_;
+    const size_t MAX_HISTORY_POINTS = 60;
+
+    void acceptConnections();
+    void readConnection(Connection& connection);
+    void closeConnection(int fd);
+};
+
+#endif
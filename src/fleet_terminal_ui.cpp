@@ -0,0 +1,242 @@
+#include "fleet_terminal_ui.h"
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const int AGGREGATOR_POLL_MS = 50;
+const int RENDER_INTERVAL_MS = 500;
+const int KEY_ESCAPE = 27;
+
+const char* sortKeyName(FleetSortKey key) {
+    switch (key) {
+        case SORT_BY_TEMPERATURE: return "temperature";
+        case SORT_BY_MEMORY: return "memory";
+        case SORT_BY_CPU:
+        default: return "cpu";
+    }
+}
+
+}
+
+FleetTerminalUI::FleetTerminalUI(FleetAggregator& aggregator) : aggregator_(aggregator),
+    running_(false), sort_key_(SORT_BY_CPU), selected_(0), scroll_(0), frames_per_second_(0.0)
+{}
+
+void FleetTerminalUI::run(const std::atomic<bool>& stop_requested) {
+    // Input is polled without blocking; the aggregator's epoll wait paces the loop instead.
+    screen_.begin(0);
+    set_escdelay(25);
+
+    running_ = true;
+    std::chrono::steady_clock::time_point last_render = std::chrono::steady_clock::now();
+    uint64_t last_frames = aggregator_.framesReceived();
+    render();
+
+    while (running_ && !stop_requested) {
+        aggregator_.poll(AGGREGATOR_POLL_MS);
+
+        bool dirty = false;
+        int ch;
+        while ((ch = getch()) != ERR) {
+            if (ch == KEY_RESIZE) {
+                screen_.resize();
+            } else {
+                handleKey(ch);
+            }
+            dirty = true;
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - last_render).count();
+        if (elapsed * 1000.0 >= RENDER_INTERVAL_MS) {
+            uint64_t frames = aggregator_.framesReceived();
+            frames_per_second_ = static_cast<double>(frames - last_frames) / elapsed;
+            last_frames = frames;
+            dirty = true;
+        }
+
+        if (dirty && running_) {
+            render();
+            if (elapsed * 1000.0 >= RENDER_INTERVAL_MS) {
+                last_render = now;
+            }
+        }
+    }
+
+    screen_.end();
+}
+
+void FleetTerminalUI::handleKey(int ch) {
+    if (ch == 'q' || ch == 'Q') {
+        running_ = false;
+        return;
+    }
+
+    if (!detail_host_.empty()) {
+        if (ch == KEY_ESCAPE || ch == KEY_BACKSPACE || ch == KEY_LEFT || ch == 'b') {
+            detail_host_.clear();
+        }
+        return;
+    }
+
+    switch (ch) {
+        case 'c': sort_key_ = SORT_BY_CPU; break;
+        case 't': sort_key_ = SORT_BY_TEMPERATURE; break;
+        case 'm': sort_key_ = SORT_BY_MEMORY; break;
+        case KEY_UP:
+        case 'k':
+            selected_ = std::max(0, selected_ - 1);
+            break;
+        case KEY_DOWN:
+        case 'j':
+            ++selected_;
+            break;
+        case KEY_NPAGE:
+            selected_ += std::max(1, screen_.rows() - 4);
+            break;
+        case KEY_PPAGE:
+            selected_ = std::max(0, selected_ - std::max(1, screen_.rows() - 4));
+            break;
+        case '\n':
+        case KEY_ENTER:
+        case KEY_RIGHT:
+            detail_host_ = selected_host_;
+            break;
+        default:
+            break;
+    }
+}
+
+void FleetTerminalUI::render() {
+    screen_.clear();
+    int cols = screen_.cols();
+
+    for (int x = 0; x < cols; ++x) {
+        screen_.putChar(0, x, L' ', A_REVERSE);
+    }
+    char title[160];
+    std::snprintf(title, sizeof(title), "System Monitor fleet  %zu connections  %.0f frames/s  sort: %s",
+                  aggregator_.connectionCount(), frames_per_second_, sortKeyName(sort_key_));
+    screen_.putText(0, 1, cols - 2, title, A_REVERSE | A_BOLD);
+
+    const FleetHost* detail = detail_host_.empty() ? nullptr : aggregator_.findHost(detail_host_);
+    if (detail) {
+        drawDetail(*detail);
+        drawFooter("Esc/b: back  q: quit");
+    } else {
+        detail_host_.clear();
+        drawOverview(aggregator_.sortedHosts(sort_key_));
+        drawFooter("c/t/m: sort by cpu/temperature/memory  Up/Down: select  Enter: details  q: quit");
+    }
+    screen_.flush();
+}
+
+void FleetTerminalUI::drawOverview(const std::vector<const FleetHost*>& hosts) {
+    int cols = screen_.cols();
+    int list_top = 2;
+    int visible_rows = screen_.rows() - list_top - 1;
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %7s %7s %9s %7s %8s %s", "HOST", "CPU%", "MEM%", "MAX TEMP", "DISK%", "AGE", "STATE");
+    screen_.putText(1, 1, cols - 2, line, COLOR_PAIR(PAIR_TITLE) | A_BOLD);
+
+    if (hosts.empty()) {
+        screen_.putText(list_top, 1, cols - 2, "Waiting for agents...", A_DIM);
+        selected_host_.clear();
+        return;
+    }
+
+    selected_ = std::min(selected_, static_cast<int>(hosts.size()) - 1);
+    if (visible_rows > 0) {
+        if (selected_ < scroll_) scroll_ = selected_;
+        if (selected_ >= scroll_ + visible_rows) scroll_ = selected_ - visible_rows + 1;
+    }
+    selected_host_ = hosts[static_cast<size_t>(selected_)]->hostname;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (int row = 0; row < visible_rows; ++row) {
+        size_t index = static_cast<size_t>(scroll_ + row);
+        if (index >= hosts.size()) break;
+        const FleetHost& host = *hosts[index];
+        int y = list_top + row;
+        bool is_selected = static_cast<int>(index) == selected_;
+        attr_t base_attr = is_selected ? A_REVERSE : A_NORMAL;
+
+        if (is_selected) {
+            for (int x = 0; x < cols; ++x) screen_.putChar(y, x, L' ', A_REVERSE);
+        }
+
+        double age = std::chrono::duration_cast<std::chrono::duration<double>>(now - host.last_update).count();
+        double max_temp = host.maxTemperature();
+
+        std::snprintf(line, sizeof(line), "%-24.24s", host.hostname.c_str());
+        screen_.putText(y, 1, 24, line, base_attr | (host.connections > 0 ? 0 : A_DIM));
+
+        std::snprintf(line, sizeof(line), "%7.1f", host.cpuPercent());
+        screen_.putText(y, 26, 7, line, base_attr | TerminalScreen::percentAttr(host.cpuPercent()));
+        std::snprintf(line, sizeof(line), "%7.1f", host.memoryPercent());
+        screen_.putText(y, 34, 7, line, base_attr | TerminalScreen::percentAttr(host.memoryPercent()));
+        if (max_temp >= 0) {
+            std::snprintf(line, sizeof(line), "%6.0f %s", max_temp, screen_.celsiusUnit());
+            screen_.putText(y, 42, 9, line, base_attr | TerminalScreen::temperatureAttr(max_temp));
+        } else {
+            screen_.putText(y, 42, 9, "      N/A", base_attr);
+        }
+        std::snprintf(line, sizeof(line), "%7.1f %7.1fs %s", host.diskPercent(), age, host.connections > 0 ? "up" : "down");
+        screen_.putText(y, 52, cols - 53, line, base_attr);
+    }
+}
+
+void FleetTerminalUI::drawDetail(const FleetHost& host) {
+    int cols = screen_.cols();
+    int width = std::min(cols, 80);
+    char buf[160];
+
+    std::snprintf(buf, sizeof(buf), "%s (%s)", host.hostname.c_str(), host.peer.c_str());
+    screen_.drawBox(1, 0, 5, width, buf);
+    std::snprintf(buf, sizeof(buf), "CPU Usage: %.1f %%", host.cpuPercent());
+    screen_.putText(2, 2, width - 4, buf, A_NORMAL);
+    screen_.drawBar(3, 2, width - 4, host.cpuPercent());
+    screen_.drawSparkline(4, 2, width - 4, host.cpu_history);
+
+    const int64_t* fields = host.snapshot.fields;
+    screen_.drawBox(6, 0, 4, width, "Memory (RAM) / Disk (Root '/')");
+    std::snprintf(buf, sizeof(buf), "RAM: %.2f / %.2f GB (%.1f %%)",
+                  static_cast<double>(fields[FIELD_MEM_USED_KB]) / (1024.0 * 1024.0),
+                  static_cast<double>(fields[FIELD_MEM_TOTAL_KB]) / (1024.0 * 1024.0), host.memoryPercent());
+    screen_.putText(7, 2, width - 4, buf, TerminalScreen::percentAttr(host.memoryPercent()));
+    std::snprintf(buf, sizeof(buf), "Disk: %lld / %lld GB (%.1f %%)",
+                  static_cast<long long>(fields[FIELD_DISK_USED_GB]),
+                  static_cast<long long>(fields[FIELD_DISK_TOTAL_GB]), host.diskPercent());
+    screen_.putText(8, 2, width - 4, buf, TerminalScreen::percentAttr(host.diskPercent()));
+
+    int temp_top = 10;
+    int temp_height = screen_.rows() - temp_top - 1;
+    if (temp_height < 3) return;
+    screen_.drawBox(temp_top, 0, temp_height, width, "Temperature (CPU/GPU/Other)");
+    const auto& names = host.snapshot.sensor_names;
+    const auto& temps = host.snapshot.temperatures_centi;
+    if (names.empty()) {
+        screen_.putText(temp_top + 1, 2, width - 4, "No temperature sensors reported", A_DIM);
+        return;
+    }
+    for (size_t i = 0; i < names.size() && static_cast<int>(i) < temp_height - 2; ++i) {
+        int y = temp_top + 1 + static_cast<int>(i);
+        screen_.putText(y, 2, width - 14, names[i], A_NORMAL);
+        if (temps[i] != -100) {
+            double value = static_cast<double>(temps[i]) / 100.0;
+            std::snprintf(buf, sizeof(buf), "%ld %s", std::lround(value), screen_.celsiusUnit());
+            screen_.putText(y, width - 10, 8, buf, TerminalScreen::temperatureAttr(value));
+        } else {
+            screen_.putText(y, width - 10, 8, "Error", A_NORMAL);
+        }
+    }
+}
+
+void FleetTerminalUI::drawFooter(const std::string& text) {
+    int rows = screen_.rows();
+    if (rows < 2) return;
+    screen_.putText(rows - 1, 1, screen_.cols() - 2, text, A_DIM);
+}
@@ -0,0 +1,36 @@
+#ifndef FLEET_TERMINAL_UI_H
+#define FLEET_TERMINAL_UI_H
+
+#include "terminal_screen.h"
+#include "fleet_aggregator.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Fleet overview for the aggregator: one row per host, sortable by CPU, temperature or memory
+// pressure, with drill-down into a single host.
+class FleetTerminalUI {
+public:
+    FleetTerminalUI(FleetAggregator& aggregator);
+    void run(const std::atomic<bool>& stop_requested);
+
+private:
+    FleetAggregator& aggregator_;
+    TerminalScreen screen_;
+
+    bool running_;
+    FleetSortKey sort_key_;
+    int selected_;
+    int scroll_;
+    std::string detail_host_;
+    std::string selected_host_;
+    double frames_per_second_;
+
+    void handleKey(int ch);
+    void render();
+    void drawOverview(const std::vector<const FleetHost*>& hosts);
+    void drawDetail(const FleetHost& host);
+    void drawFooter(const std::string& text);
+};
+
+#endif
@@ -1,16 +1,56 @@
 #include "gui_manager.h"
 #include <iostream>
-#include <iomanip>
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+// Pages that are not visible are only refreshed on every Nth tick.
+const unsigned long BACKGROUND_UPDATE_DIVISOR = 5;
+
+enum TempSeverity { TEMP_NORMAL, TEMP_WARNING, TEMP_CRITICAL, TEMP_SEVERITY_COUNT };
+const char* const TEMP_SEVERITY_CLASSES[TEMP_SEVERITY_COUNT] = {"temp-normal", "temp-warning", "temp-critical"};
+
+template <size_t N>
+size_t formatFixed(char (&buf)[N], double value, int precision, const char* suffix) {
+    size_t suffix_length = std::strlen(suffix);
+    auto result = std::to_chars(buf, buf + N - suffix_length, value, std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        return 0;
+    }
+    std::memcpy(result.ptr, suffix, suffix_length);
+    return static_cast<size_t>(result.ptr - buf) + suffix_length;
+}
+
+template <size_t N>
+size_t formatInteger(char (&buf)[N], long value, const char* suffix) {
+    size_t suffix_length = std::strlen(suffix);
+    auto result = std::to_chars(buf, buf + N - suffix_length, value);
+    if (result.ec != std::errc()) {
+        return 0;
+    }
+    std::memcpy(result.ptr, suffix, suffix_length);
+    return static_cast<size_t>(result.ptr - buf) + suffix_length;
+}
+
+}
 
 GUIManager::GUIManager(SystemData& sys_data) : sysdata(sys_data),
     window_(nullptr), notebook_(nullptr),
-    temp_grid_(nullptr), cpu_mem_grid_(nullptr), disk_grid_(nullptr), settings_grid_(nullptr),
+    temp_grid_(nullptr), cpu_mem_grid_(nullptr), disk_grid_(nullptr), irq_grid_(nullptr), numa_grid_(nullptr), settings_grid_(nullptr),
+    temp_page_(-1), cpu_mem_page_(-1), disk_page_(-1), irq_page_(-1), numa_page_(-1), tick_count_(0), last_cpu_usage_(0.0),
+    temp_status_label_(nullptr), temp_next_row_(0),
+    power_status_label_(nullptr), cpu_freq_chart_area_(nullptr),
+    freq_avg_label_(nullptr), freq_min_label_(nullptr), freq_max_label_(nullptr),
+    power_next_row_(0), power_rows_built_(false), cpu_freq_peak_mhz_(0.0),
     cpu_usage_label_(nullptr), cpu_chart_area_(nullptr),
     mem_total_label_(nullptr), mem_used_label_(nullptr), mem_free_label_(nullptr), mem_usage_label_(nullptr),
     disk_total_label_(nullptr), disk_used_label_(nullptr), disk_free_label_(nullptr), disk_usage_label_(nullptr),
+    hard_irq_chart_area_(nullptr), soft_irq_chart_area_(nullptr),
+    numa_status_label_(nullptr), numa_cpu_chart_area_(nullptr), numa_mem_chart_area_(nullptr), numa_rows_built_(false),
     update_interval_spin_button_(nullptr), timeout_source_id_(0)
 {}
 
@@ -51,7 +91,7 @@ void GUIManager::onActivate(GtkApplication* app) {
     gtk_grid_set_row_spacing(GTK_GRID(temp_grid_), 5);
     gtk_grid_set_column_spacing(GTK_GRID(temp_grid_), 10);
     gtk_container_set_border_width(GTK_CONTAINER(temp_grid_), 10);
-    gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), temp_grid_, gtk_label_new("Temperatures"));
+    temp_page_ = gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), temp_grid_, gtk_label_new("Temperatures"));
 
     int row = 0;
     GtkWidget* temp_section_label = gtk_label_new("<span>Temperature (CPU/GPU/Other)</span>");
@@ -59,24 +99,37 @@ void GUIManager::onActivate(GtkApplication* app) {
     gtk_widget_set_halign(temp_section_label, GTK_ALIGN_CENTER);
     gtk_grid_attach(GTK_GRID(temp_grid_), temp_section_label, 0, row++, 2, 1);
 
-    auto all_temps = sysdata.getAllTemperatures();
-    for (const auto& pair : all_temps) {
-        GtkWidget* name_label = gtk_label_new(pair.first.c_str());
-        gtk_widget_set_halign(name_label, GTK_ALIGN_START);
-        gtk_grid_attach(GTK_GRID(temp_grid_), name_label, 0, row, 1, 1);
+    temp_status_label_ = gtk_label_new("Discovering sensors...");
+    gtk_widget_set_halign(temp_status_label_, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(temp_grid_), temp_status_label_, 0, row++, 2, 1);
+    temp_next_row_ = row;
 
-        GtkWidget* temp_label = gtk_label_new("N/A");
-        gtk_widget_set_halign(temp_label, GTK_ALIGN_END);
-        gtk_grid_attach(GTK_GRID(temp_grid_), temp_label, 1, row, 1, 1);
-        templabels[pair.first] = temp_label;
-        row++;
-    }
+    // Frequency, idle residency and package power sit in columns 2-3, beside the temperatures.
+    row = 0;
+    GtkWidget* power_section_label = gtk_label_new("<span>CPU Frequency &amp; Power</span>");
+    gtk_label_set_use_markup(GTK_LABEL(power_section_label), TRUE);
+    gtk_widget_set_halign(power_section_label, GTK_ALIGN_CENTER);
+    gtk_grid_attach(GTK_GRID(temp_grid_), power_section_label, 2, row++, 2, 1);
+
+    power_status_label_ = gtk_label_new("Reading cpufreq...");
+    gtk_widget_set_halign(power_status_label_, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(temp_grid_), power_status_label_, 2, row++, 2, 1);
+
+    GtkWidget* cpu_freq_chart_frame = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(cpu_freq_chart_frame), GTK_SHADOW_IN);
+    gtk_grid_attach(GTK_GRID(temp_grid_), cpu_freq_chart_frame, 2, row++, 2, 1);
+
+    cpu_freq_chart_area_ = gtk_drawing_area_new();
+    gtk_widget_set_size_request(cpu_freq_chart_area_, 260, 100);
+    gtk_container_add(GTK_CONTAINER(cpu_freq_chart_frame), cpu_freq_chart_area_);
+    g_signal_connect(G_OBJECT(cpu_freq_chart_area_), "draw", G_CALLBACK(on_draw_cpu_freq_chart), this);
+    power_next_row_ = row;
 
     cpu_mem_grid_ = gtk_grid_new();
     gtk_grid_set_row_spacing(GTK_GRID(cpu_mem_grid_), 5);
     gtk_grid_set_column_spacing(GTK_GRID(cpu_mem_grid_), 10);
     gtk_container_set_border_width(GTK_CONTAINER(cpu_mem_grid_), 10);
-    gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), cpu_mem_grid_, gtk_label_new("CPU & Memory"));
+    cpu_mem_page_ = gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), cpu_mem_grid_, gtk_label_new("CPU & Memory"));
 
     row = 0;
 
@@ -140,7 +193,7 @@ void GUIManager::onActivate(GtkApplication* app) {
     gtk_grid_set_row_spacing(GTK_GRID(disk_grid_), 5);
     gtk_grid_set_column_spacing(GTK_GRID(disk_grid_), 10);
     gtk_container_set_border_width(GTK_CONTAINER(disk_grid_), 10);
-    gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), disk_grid_, gtk_label_new("Disk Usage"));
+    disk_page_ = gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), disk_grid_, gtk_label_new("Disk Usage"));
 
     row = 0;
     GtkWidget* disk_section_label = gtk_label_new("<span>Disk Usage (Root '/')</span>");
@@ -176,6 +229,59 @@ void GUIManager::onActivate(GtkApplication* app) {
     gtk_widget_set_halign(disk_usage_label_, GTK_ALIGN_END);
     gtk_grid_attach(GTK_GRID(disk_grid_), disk_usage_label_, 1, row++, 1, 1);
 
+    irq_grid_ = gtk_grid_new();
+    gtk_grid_set_row_spacing(GTK_GRID(irq_grid_), 5);
+    gtk_grid_set_column_spacing(GTK_GRID(irq_grid_), 10);
+    gtk_container_set_border_width(GTK_CONTAINER(irq_grid_), 10);
+    irq_page_ = gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), irq_grid_, gtk_label_new("Interrupts"));
+
+    row = 0;
+    GtkWidget* hard_irq_section_label = gtk_label_new("<span>Hardware IRQs per CPU (/proc/interrupts)</span>");
+    gtk_label_set_use_markup(GTK_LABEL(hard_irq_section_label), TRUE);
+    gtk_widget_set_halign(hard_irq_section_label, GTK_ALIGN_CENTER);
+    gtk_grid_attach(GTK_GRID(irq_grid_), hard_irq_section_label, 0, row++, 1, 1);
+
+    GtkWidget* hard_irq_chart_frame = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(hard_irq_chart_frame), GTK_SHADOW_IN);
+    gtk_widget_set_hexpand(hard_irq_chart_frame, TRUE);
+    gtk_widget_set_vexpand(hard_irq_chart_frame, TRUE);
+    gtk_grid_attach(GTK_GRID(irq_grid_), hard_irq_chart_frame, 0, row++, 1, 1);
+
+    hard_irq_chart_area_ = gtk_drawing_area_new();
+    gtk_widget_set_size_request(hard_irq_chart_area_, 500, 300);
+    gtk_container_add(GTK_CONTAINER(hard_irq_chart_frame), hard_irq_chart_area_);
+    g_signal_connect(G_OBJECT(hard_irq_chart_area_), "draw", G_CALLBACK(on_draw_hard_irq_chart), this);
+
+    GtkWidget* soft_irq_section_label = gtk_label_new("<span>Softirqs per CPU (/proc/softirqs)</span>");
+    gtk_label_set_use_markup(GTK_LABEL(soft_irq_section_label), TRUE);
+    gtk_widget_set_halign(soft_irq_section_label, GTK_ALIGN_CENTER);
+    gtk_grid_attach(GTK_GRID(irq_grid_), soft_irq_section_label, 0, row++, 1, 1);
+
+    GtkWidget* soft_irq_chart_frame = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(soft_irq_chart_frame), GTK_SHADOW_IN);
+    gtk_widget_set_hexpand(soft_irq_chart_frame, TRUE);
+    gtk_grid_attach(GTK_GRID(irq_grid_), soft_irq_chart_frame, 0, row++, 1, 1);
+
+    soft_irq_chart_area_ = gtk_drawing_area_new();
+    gtk_widget_set_size_request(soft_irq_chart_area_, 500, 150);
+    gtk_container_add(GTK_CONTAINER(soft_irq_chart_frame), soft_irq_chart_area_);
+    g_signal_connect(G_OBJECT(soft_irq_chart_area_), "draw", G_CALLBACK(on_draw_soft_irq_chart), this);
+
+    numa_grid_ = gtk_grid_new();
+    gtk_grid_set_row_spacing(GTK_GRID(numa_grid_), 5);
+    gtk_grid_set_column_spacing(GTK_GRID(numa_grid_), 10);
+    gtk_container_set_border_width(GTK_CONTAINER(numa_grid_), 10);
+    numa_page_ = gtk_notebook_append_page(GTK_NOTEBOOK(notebook_), numa_grid_, gtk_label_new("NUMA"));
+
+    row = 0;
+    GtkWidget* numa_section_label = gtk_label_new("<span>NUMA Nodes</span>");
+    gtk_label_set_use_markup(GTK_LABEL(numa_section_label), TRUE);
+    gtk_widget_set_halign(numa_section_label, GTK_ALIGN_CENTER);
+    gtk_grid_attach(GTK_GRID(numa_grid_), numa_section_label, 0, row++, 7, 1);
+
+    numa_status_label_ = gtk_label_new("Reading node topology...");
+    gtk_widget_set_halign(numa_status_label_, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(numa_grid_), numa_status_label_, 0, row++, 7, 1);
 
     settings_grid_ = gtk_grid_new();
     gtk_grid_set_row_spacing(GTK_GRID(settings_grid_), 5);
@@ -199,12 +305,62 @@ void GUIManager::onActivate(GtkApplication* app) {
     gtk_grid_attach(GTK_GRID(settings_grid_), update_interval_spin_button_, 1, row++, 1, 1);
 
     g_signal_connect(G_OBJECT(update_interval_spin_button_), "value-changed", G_CALLBACK(on_update_interval_changed), this);
+    g_signal_connect(G_OBJECT(notebook_), "switch-page", G_CALLBACK(on_switch_page), this);
 
-    onUpdateData();
+    // Paint the window with placeholders first; sensor discovery runs on a worker thread and the
+    // first sample is taken from an idle callback, which GTK dispatches after the initial frame.
+    gtk_widget_show_all(window_);
+
+    sysdata.startSensorDiscovery([this]() {
+        g_idle_add(sensors_found_cb, this);
+    });
+    g_idle_add(first_update_cb, this);
 
     timeout_source_id_ = g_timeout_add_seconds(2, update_data_cb, this);
+}
 
-    gtk_widget_show_all(window_);
+gboolean GUIManager::first_update_cb(gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    self->onUpdateData();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean GUIManager::sensors_found_cb(gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    self->onSensorsFound();
+    return G_SOURCE_REMOVE;
+}
+
+void GUIManager::onSensorsFound() {
+    auto new_temps = sysdata.takeDiscoveredSensors();
+    for (const auto& pair : new_temps) {
+        if (templabels.count(pair.first)) continue;
+
+        GtkWidget* name_label = gtk_label_new(pair.first.c_str());
+        gtk_widget_set_halign(name_label, GTK_ALIGN_START);
+        gtk_grid_attach(GTK_GRID(temp_grid_), name_label, 0, temp_next_row_, 1, 1);
+
+        GtkWidget* temp_label = gtk_label_new("N/A");
+        gtk_widget_set_halign(temp_label, GTK_ALIGN_END);
+        gtk_grid_attach(GTK_GRID(temp_grid_), temp_label, 1, temp_next_row_, 1, 1);
+        templabels[pair.first] = temp_label;
+        setTemperatureLabel(temp_label, pair.second);
+
+        gtk_widget_show(name_label);
+        gtk_widget_show(temp_label);
+        temp_next_row_++;
+    }
+
+    if (sysdata.isSensorDiscoveryDone()) {
+        if (templabels.empty()) {
+            gtk_label_set_text(GTK_LABEL(temp_status_label_), "No temperature sensors found");
+        } else {
+            gtk_widget_set_visible(temp_status_label_, FALSE);
+        }
+        if (!power_rows_built_) {
+            updateCpuPowerLabels();
+        }
+    }
 }
 
 gboolean GUIManager::update_data_cb(gpointer user_data) {
@@ -224,112 +380,375 @@ void GUIManager::on_update_interval_changed(GtkSpinButton* spinner, gpointer use
     std::cout << "Update interval changed to " << new_interval << " seconds." << std::endl;
 }
 
+void GUIManager::on_switch_page(GtkNotebook* notebook, GtkWidget* page, guint page_num, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    self->refreshPage(static_cast<int>(page_num));
+}
+
 gboolean GUIManager::onUpdateData() {
-    updateTemperatureLabels();
-    updateCpuUsageLabel();
-    updateMemoryLabels();
-    updateDiskLabels();
+    int current_page = gtk_notebook_get_current_page(GTK_NOTEBOOK(notebook_));
+    bool background_tick = (tick_count_++ % BACKGROUND_UPDATE_DIVISOR) == 0;
+
+    // The CPU history feeds the chart, so it is sampled on every tick even while its page is hidden.
+    last_cpu_usage_ = sysdata.getCpuUsage();
 
-    if (cpu_chart_area_) {
-        gtk_widget_queue_draw(cpu_chart_area_);
+    if (current_page == temp_page_ || background_tick) {
+        updateTemperatureLabels();
+        updateCpuPowerLabels();
+    }
+    // The visible CPU/memory page is refreshed below, so only hidden-page background ticks read memory here.
+    if (current_page != cpu_mem_page_ && background_tick) {
+        updateMemoryLabels();
+    }
+    if (current_page == disk_page_ || background_tick) {
+        updateDiskLabels();
+    }
+    if (current_page == irq_page_ || background_tick) {
+        sysdata.updateInterruptStats();
+    }
+    // Like the CPU history, node history is sampled every tick; only the labels follow visibility.
+    sysdata.updateNumaStats();
+    if (current_page == numa_page_ || background_tick) {
+        updateNumaLabels();
+    }
+
+    if (current_page == cpu_mem_page_) {
+        refreshPage(cpu_mem_page_);
+    } else if (current_page == irq_page_) {
+        refreshPage(irq_page_);
+    } else if (current_page == numa_page_) {
+        refreshPage(numa_page_);
     }
 
     return G_SOURCE_CONTINUE;
 }
 
+void GUIManager::refreshPage(int page) {
+    if (page == temp_page_) {
+        updateTemperatureLabels();
+        updateCpuPowerLabels();
+    } else if (page == cpu_mem_page_) {
+        updateCpuUsageLabel(last_cpu_usage_);
+        updateMemoryLabels();
+        if (cpu_chart_area_) {
+            gtk_widget_queue_draw(cpu_chart_area_);
+        }
+    } else if (page == disk_page_) {
+        updateDiskLabels();
+    } else if (page == irq_page_) {
+        if (hard_irq_chart_area_) {
+            gtk_widget_queue_draw(hard_irq_chart_area_);
+        }
+        if (soft_irq_chart_area_) {
+            gtk_widget_queue_draw(soft_irq_chart_area_);
+        }
+    } else if (page == numa_page_) {
+        updateNumaLabels();
+        if (numa_cpu_chart_area_) {
+            gtk_widget_queue_draw(numa_cpu_chart_area_);
+        }
+        if (numa_mem_chart_area_) {
+            gtk_widget_queue_draw(numa_mem_chart_area_);
+        }
+    }
+}
+
+void GUIManager::setLabelText(GtkWidget* label, const char* text, size_t length) {
+    LabelState& state = label_states_[label];
+    if (state.text.size() == length && state.text.compare(0, length, text, length) == 0) {
+        return;
+    }
+    state.text.assign(text, length);
+    gtk_label_set_text(GTK_LABEL(label), state.text.c_str());
+}
+
+void GUIManager::setLabelText(GtkWidget* label, const char* text) {
+    setLabelText(label, text, std::strlen(text));
+}
+
+void GUIManager::setLabelSeverity(GtkWidget* label, int severity) {
+    LabelState& state = label_states_[label];
+    if (state.severity == severity) {
+        return;
+    }
+    GtkStyleContext *context = gtk_widget_get_style_context(label);
+    if (state.severity >= 0) {
+        gtk_style_context_remove_class(context, TEMP_SEVERITY_CLASSES[state.severity]);
+    }
+    if (severity >= 0) {
+        gtk_style_context_add_class(context, TEMP_SEVERITY_CLASSES[severity]);
+    }
+    state.severity = severity;
+}
+
 void GUIManager::updateTemperatureLabels() {
     auto current_temps = sysdata.getAllTemperatures();
     for (const auto& pair : current_temps) {
         if (templabels.count(pair.first)) {
-            std::string temp_str;
-            double temp_value = pair.second;
-            GtkWidget* temp_label = templabels[pair.first];
+            setTemperatureLabel(templabels[pair.first], pair.second);
+        }
+    }
+}
 
-            GtkStyleContext *context = gtk_widget_get_style_context(temp_label);
-            gtk_style_context_remove_class(context, "temp-normal");
-            gtk_style_context_remove_class(context, "temp-warning");
-            gtk_style_context_remove_class(context, "temp-critical");
+void GUIManager::setTemperatureLabel(GtkWidget* temp_label, double temp_value) {
+    if (temp_value != -1.0) {
+        char buf[32];
+        size_t length = formatInteger(buf, std::lround(temp_value), " °C");
+        setLabelText(temp_label, buf, length);
 
+        if (temp_value >= 85.0) {
+            setLabelSeverity(temp_label, TEMP_CRITICAL);
+        } else if (temp_value >= 75.0) {
+            setLabelSeverity(temp_label, TEMP_WARNING);
+        } else {
+            setLabelSeverity(temp_label, TEMP_NORMAL);
+        }
+    } else {
+        setLabelText(temp_label, "Error");
+        setLabelSeverity(temp_label, -1);
+    }
+}
 
-            if (temp_value != -1.0) {
-                temp_str = std::to_string(static_cast<int>(std::round(temp_value))) + " °C";
+GtkWidget* GUIManager::addPowerRow(const std::string& name) {
+    GtkWidget* name_label = gtk_label_new(name.c_str());
+    gtk_widget_set_halign(name_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(temp_grid_), name_label, 2, power_next_row_, 1, 1);
 
-                if (temp_value >= 85.0) {
-                    gtk_style_context_add_class(context, "temp-critical");
-                } else if (temp_value >= 75.0) {
-                    gtk_style_context_add_class(context, "temp-warning");
-                } else {
-                    gtk_style_context_add_class(context, "temp-normal");
-                }
+    GtkWidget* value_label = gtk_label_new("N/A");
+    gtk_widget_set_halign(value_label, GTK_ALIGN_END);
+    gtk_grid_attach(GTK_GRID(temp_grid_), value_label, 3, power_next_row_, 1, 1);
 
-            } else {
-                temp_str = "Error";
-            }
-            gtk_label_set_text(GTK_LABEL(temp_label), temp_str.c_str());
+    gtk_widget_show(name_label);
+    gtk_widget_show(value_label);
+    power_next_row_++;
+    return value_label;
+}
+
+void GUIManager::buildCpuPowerRows(const CpuPowerStats& power) {
+    const std::vector<double>& frequencies = power.frequenciesMhz();
+    bool have_cpufreq = std::any_of(frequencies.begin(), frequencies.end(), [](double mhz) { return mhz >= 0; });
+    if (have_cpufreq) {
+        freq_avg_label_ = addPowerRow("Average frequency:");
+        freq_min_label_ = addPowerRow("Slowest core:");
+        freq_max_label_ = addPowerRow("Fastest core:");
+    }
+    for (const RaplDomain& domain : power.raplDomains()) {
+        rapl_labels_.push_back(addPowerRow(domain.name + ":"));
+    }
+    for (const std::string& state_name : power.idleStateNames()) {
+        idle_state_labels_.push_back(addPowerRow(state_name + " residency:"));
+    }
+
+    if (!have_cpufreq && power.idleStateNames().empty() && power.raplDomains().empty()) {
+        gtk_label_set_text(GTK_LABEL(power_status_label_), "No cpufreq, cpuidle or RAPL data available");
+    } else {
+        gtk_widget_set_visible(power_status_label_, FALSE);
+    }
+    power_rows_built_ = true;
+}
+
+void GUIManager::updateCpuPowerLabels() {
+    if (!sysdata.updateCpuPowerStats()) {
+        return;
+    }
+    const CpuPowerStats& power = sysdata.getCpuPowerStats();
+    if (!power_rows_built_) {
+        buildCpuPowerRows(power);
+    }
+    char buf[32];
+
+    if (freq_avg_label_) {
+        double total = 0.0;
+        double lowest = 0.0;
+        double highest = 0.0;
+        int count = 0;
+        for (double mhz : power.frequenciesMhz()) {
+            if (mhz < 0) continue;
+            lowest = count == 0 ? mhz : std::min(lowest, mhz);
+            highest = std::max(highest, mhz);
+            total += mhz;
+            ++count;
         }
+        if (count > 0) {
+            cpu_freq_peak_mhz_ = std::max(cpu_freq_peak_mhz_, highest);
+            setLabelText(freq_avg_label_, buf, formatInteger(buf, std::lround(total / count), " MHz"));
+            setLabelText(freq_min_label_, buf, formatInteger(buf, std::lround(lowest), " MHz"));
+            setLabelText(freq_max_label_, buf, formatInteger(buf, std::lround(highest), " MHz"));
+        } else {
+            setLabelText(freq_avg_label_, "N/A");
+            setLabelText(freq_min_label_, "N/A");
+            setLabelText(freq_max_label_, "N/A");
+        }
+    }
+
+    const std::vector<RaplDomain>& domains = power.raplDomains();
+    for (size_t i = 0; i < rapl_labels_.size() && i < domains.size(); ++i) {
+        setLabelText(rapl_labels_[i], buf, formatFixed(buf, domains[i].watts, 1, " W"));
+    }
+    for (size_t i = 0; i < idle_state_labels_.size(); ++i) {
+        setLabelText(idle_state_labels_[i], buf, formatFixed(buf, power.averageIdleResidencyPercent(i), 1, " %"));
+    }
+
+    if (cpu_freq_chart_area_) {
+        gtk_widget_queue_draw(cpu_freq_chart_area_);
     }
 }
 
-void GUIManager::updateCpuUsageLabel() {
-    double cpu_usage = sysdata.getCpuUsage();
-    std::stringstream ss;
+void GUIManager::buildNumaRows(const NumaStats& numa) {
+    numa_rows_built_ = true;
+    if (!numa.isAvailable()) {
+        gtk_label_set_text(GTK_LABEL(numa_status_label_), "NUMA topology is not available on this system");
+        return;
+    }
+    if (numa.isMultiNode()) {
+        gtk_widget_set_visible(numa_status_label_, FALSE);
+    } else {
+        gtk_label_set_text(GTK_LABEL(numa_status_label_), "Single NUMA node");
+    }
+
+    int row = 2;
+    const char* const headers[] = {"Node", "CPUs", "CPU %", "Memory", "Hit /s", "Miss /s", "Foreign /s"};
+    for (int column = 0; column < 7; ++column) {
+        GtkWidget* header = gtk_label_new(headers[column]);
+        gtk_widget_set_halign(header, column < 2 ? GTK_ALIGN_START : GTK_ALIGN_END);
+        gtk_grid_attach(GTK_GRID(numa_grid_), header, column, row, 1, 1);
+        gtk_widget_show(header);
+    }
+    row++;
+
+    for (const NumaNode& node : numa.nodes()) {
+        std::string name = "node" + std::to_string(node.id);
+        GtkWidget* name_label = gtk_label_new(name.c_str());
+        gtk_widget_set_halign(name_label, GTK_ALIGN_START);
+        gtk_grid_attach(GTK_GRID(numa_grid_), name_label, 0, row, 1, 1);
+        gtk_widget_show(name_label);
+
+        GtkWidget* cpus_label = gtk_label_new(node.cpu_list.empty() ? "-" : node.cpu_list.c_str());
+        gtk_widget_set_halign(cpus_label, GTK_ALIGN_START);
+        gtk_grid_attach(GTK_GRID(numa_grid_), cpus_label, 1, row, 1, 1);
+        gtk_widget_show(cpus_label);
+
+        NumaRowLabels labels;
+        GtkWidget** value_labels[] = {&labels.cpu, &labels.memory, &labels.hit, &labels.miss, &labels.foreign};
+        for (int column = 0; column < 5; ++column) {
+            *value_labels[column] = gtk_label_new("N/A");
+            gtk_widget_set_halign(*value_labels[column], GTK_ALIGN_END);
+            gtk_grid_attach(GTK_GRID(numa_grid_), *value_labels[column], column + 2, row, 1, 1);
+            gtk_widget_show(*value_labels[column]);
+        }
+        numa_row_labels_.push_back(labels);
+        row++;
+    }
+
+    GtkWidget* cpu_chart_label = gtk_label_new("CPU usage per node");
+    gtk_widget_set_halign(cpu_chart_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(numa_grid_), cpu_chart_label, 0, row++, 7, 1);
+
+    GtkWidget* cpu_chart_frame = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(cpu_chart_frame), GTK_SHADOW_IN);
+    gtk_widget_set_hexpand(cpu_chart_frame, TRUE);
+    gtk_grid_attach(GTK_GRID(numa_grid_), cpu_chart_frame, 0, row++, 7, 1);
+
+    numa_cpu_chart_area_ = gtk_drawing_area_new();
+    gtk_widget_set_size_request(numa_cpu_chart_area_, 500, 130);
+    gtk_container_add(GTK_CONTAINER(cpu_chart_frame), numa_cpu_chart_area_);
+    g_signal_connect(G_OBJECT(numa_cpu_chart_area_), "draw", G_CALLBACK(on_draw_numa_cpu_chart), this);
+
+    GtkWidget* mem_chart_label = gtk_label_new("Memory usage per node");
+    gtk_widget_set_halign(mem_chart_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(numa_grid_), mem_chart_label, 0, row++, 7, 1);
+
+    GtkWidget* mem_chart_frame = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(mem_chart_frame), GTK_SHADOW_IN);
+    gtk_widget_set_hexpand(mem_chart_frame, TRUE);
+    gtk_grid_attach(GTK_GRID(numa_grid_), mem_chart_frame, 0, row++, 7, 1);
+
+    numa_mem_chart_area_ = gtk_drawing_area_new();
+    gtk_widget_set_size_request(numa_mem_chart_area_, 500, 130);
+    gtk_container_add(GTK_CONTAINER(mem_chart_frame), numa_mem_chart_area_);
+    g_signal_connect(G_OBJECT(numa_mem_chart_area_), "draw", G_CALLBACK(on_draw_numa_mem_chart), this);
+
+    gtk_widget_show_all(cpu_chart_frame);
+    gtk_widget_show_all(mem_chart_frame);
+    gtk_widget_show(cpu_chart_label);
+    gtk_widget_show(mem_chart_label);
+}
+
+void GUIManager::updateNumaLabels() {
+    const NumaStats& numa = sysdata.getNumaStats();
+    if (!numa.isDiscovered()) {
+        return;
+    }
+    if (!numa_rows_built_) {
+        buildNumaRows(numa);
+    }
+
+    char buf[64];
+    const std::vector<NumaNode>& nodes = numa.nodes();
+    for (size_t i = 0; i < numa_row_labels_.size() && i < nodes.size(); ++i) {
+        const NumaNode& node = nodes[i];
+        const NumaRowLabels& labels = numa_row_labels_[i];
+        setLabelText(labels.cpu, buf, formatFixed(buf, node.cpu_usage_percent, 1, " %"));
+        if (node.mem_total_kb > 0) {
+            double used_gb = static_cast<double>(node.mem_used_kb) / (1024.0 * 1024.0);
+            char percent_buf[16];
+            size_t length = formatFixed(buf, used_gb, 2, " GB (");
+            size_t percent_length = formatFixed(percent_buf, node.mem_usage_percent, 0, "%)");
+            std::memcpy(buf + length, percent_buf, percent_length);
+            setLabelText(labels.memory, buf, length + percent_length);
+        } else {
+            setLabelText(labels.memory, node.mem_total_kb == 0 ? "-" : "Error");
+        }
+        setLabelText(labels.hit, buf, formatInteger(buf, std::lround(node.hit_per_second), ""));
+        setLabelText(labels.miss, buf, formatInteger(buf, std::lround(node.miss_per_second), ""));
+        setLabelText(labels.foreign, buf, formatInteger(buf, std::lround(node.foreign_per_second), ""));
+    }
+}
+
+void GUIManager::updateCpuUsageLabel(double cpu_usage) {
     if (cpu_usage >= 0) {
-        ss << std::fixed << std::setprecision(1) << cpu_usage << " %";
+        char buf[32];
+        setLabelText(cpu_usage_label_, buf, formatFixed(buf, cpu_usage, 1, " %"));
     } else {
-        ss << "Error";
+        setLabelText(cpu_usage_label_, "Error");
     }
-    gtk_label_set_text(GTK_LABEL(cpu_usage_label_), ss.str().c_str());
 }
 
 void GUIManager::updateMemoryLabels() {
     MemoryInfo mem_info = sysdata.getMemoryInfo();
-    std::stringstream ss;
+    char buf[64];
 
     if (mem_info.total_kb > 0) {
         double total_gb = static_cast<double>(mem_info.total_kb) / (1024.0 * 1024.0);
         double used_gb = static_cast<double>(mem_info.used_kb) / (1024.0 * 1024.0);
         double free_gb = static_cast<double>(mem_info.available_kb) / (1024.0 * 1024.0);
 
-        ss.str(""); ss << std::fixed << std::setprecision(2) << total_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(mem_total_label_), ss.str().c_str());
-
-        ss.str(""); ss << std::fixed << std::setprecision(2) << used_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(mem_used_label_), ss.str().c_str());
-
-        ss.str(""); ss << std::fixed << std::setprecision(2) << free_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(mem_free_label_), ss.str().c_str());
-
-        ss.str(""); ss << std::fixed << std::setprecision(1) << mem_info.usage_percent << " %";
-        gtk_label_set_text(GTK_LABEL(mem_usage_label_), ss.str().c_str());
+        setLabelText(mem_total_label_, buf, formatFixed(buf, total_gb, 2, " GB"));
+        setLabelText(mem_used_label_, buf, formatFixed(buf, used_gb, 2, " GB"));
+        setLabelText(mem_free_label_, buf, formatFixed(buf, free_gb, 2, " GB"));
+        setLabelText(mem_usage_label_, buf, formatFixed(buf, mem_info.usage_percent, 1, " %"));
     } else {
-        gtk_label_set_text(GTK_LABEL(mem_total_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(mem_used_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(mem_free_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(mem_usage_label_), "Error");
+        setLabelText(mem_total_label_, "Error");
+        setLabelText(mem_used_label_, "Error");
+        setLabelText(mem_free_label_, "Error");
+        setLabelText(mem_usage_label_, "Error");
     }
 }
 
 void GUIManager::updateDiskLabels() {
     DiskInfo disk_info = sysdata.getDiskUsage("/");
-    std::stringstream ss;
+    char buf[64];
 
     if (disk_info.total_space_gb >= 0) {
-        ss.str(""); ss << disk_info.total_space_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(disk_total_label_), ss.str().c_str());
-
-        ss.str(""); ss << disk_info.used_space_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(disk_used_label_), ss.str().c_str());
-
-        ss.str(""); ss << disk_info.free_space_gb << " GB";
-        gtk_label_set_text(GTK_LABEL(disk_free_label_), ss.str().c_str());
-
-        ss.str(""); ss << std::fixed << std::setprecision(1) << disk_info.usage_percent << " %";
-        gtk_label_set_text(GTK_LABEL(disk_usage_label_), ss.str().c_str());
+        setLabelText(disk_total_label_, buf, formatInteger(buf, disk_info.total_space_gb, " GB"));
+        setLabelText(disk_used_label_, buf, formatInteger(buf, disk_info.used_space_gb, " GB"));
+        setLabelText(disk_free_label_, buf, formatInteger(buf, disk_info.free_space_gb, " GB"));
+        setLabelText(disk_usage_label_, buf, formatFixed(buf, disk_info.usage_percent, 1, " %"));
     } else {
-        gtk_label_set_text(GTK_LABEL(disk_total_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(disk_used_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(disk_free_label_), "Error");
-        gtk_label_set_text(GTK_LABEL(disk_usage_label_), "Error");
+        setLabelText(disk_total_label_, "Error");
+        setLabelText(disk_used_label_, "Error");
+        setLabelText(disk_free_label_, "Error");
+        setLabelText(disk_usage_label_, "Error");
     }
 }
 
@@ -405,4 +824,229 @@ gboolean GUIManager::on_draw_cpu_chart(GtkWidget *widget, cairo_t *cr, gpointer
     }
 
     return FALSE;
-}
\ No newline at end of file
+}
+
+gboolean GUIManager::on_draw_cpu_freq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    GtkAllocation allocation;
+    gtk_widget_get_allocation(widget, &allocation);
+    double width = static_cast<double>(allocation.width);
+    double height = static_cast<double>(allocation.height);
+
+    cairo_set_source_rgb(cr, 0.95, 0.95, 0.95);
+    cairo_paint(cr);
+
+    // The peak is only set once the power collector has been discovered and sampled.
+    if (self->cpu_freq_peak_mhz_ <= 0 || self->sysdata.getCpuPowerStats().frequenciesMhz().empty()) {
+        cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+        cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+        cairo_set_font_size(cr, 14);
+        cairo_move_to(cr, width / 2 - 40, height / 2);
+        cairo_show_text(cr, "No data");
+        return FALSE;
+    }
+    const std::vector<double>& frequencies = self->sysdata.getCpuPowerStats().frequenciesMhz();
+
+    // One bar per core, scaled to the highest frequency seen since startup.
+    double padding = 5;
+    double plot_height = height - 2 * padding;
+    double bar_width = (width - 2 * padding) / frequencies.size();
+    double gap = bar_width >= 4 ? 1 : 0;
+
+    cairo_set_source_rgb(cr, 0.0, 0.4, 0.8);
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        if (frequencies[i] <= 0) continue;
+        double bar_height = std::min(1.0, frequencies[i] / self->cpu_freq_peak_mhz_) * plot_height;
+        cairo_rectangle(cr, padding + i * bar_width, padding + plot_height - bar_height, bar_width - gap, bar_height);
+    }
+    cairo_fill(cr);
+
+    char peak_label[32];
+    size_t length = formatInteger(peak_label, std::lround(self->cpu_freq_peak_mhz_), " MHz peak");
+    peak_label[std::min(length, sizeof(peak_label) - 1)] = '\0';
+    cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 9);
+    cairo_move_to(cr, padding + 2, padding + 9);
+    cairo_show_text(cr, peak_label);
+    return FALSE;
+}
+
+gboolean GUIManager::on_draw_numa_cpu_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    drawNumaHistory(widget, cr, self->sysdata.getNumaStats(), self->sysdata.getMaxHistoryPoints(), false);
+    return FALSE;
+}
+
+gboolean GUIManager::on_draw_numa_mem_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    drawNumaHistory(widget, cr, self->sysdata.getNumaStats(), self->sysdata.getMaxHistoryPoints(), true);
+    return FALSE;
+}
+
+void GUIManager::drawNumaHistory(GtkWidget *widget, cairo_t *cr, const NumaStats& numa, size_t max_points, bool memory) {
+    static const double NODE_COLORS[][3] = {
+        {0.0, 0.4, 0.8}, {0.85, 0.35, 0.0}, {0.1, 0.6, 0.2}, {0.6, 0.2, 0.7},
+        {0.8, 0.1, 0.3}, {0.0, 0.6, 0.6}, {0.5, 0.5, 0.0}, {0.3, 0.3, 0.3},
+    };
+    const size_t color_count = sizeof(NODE_COLORS) / sizeof(NODE_COLORS[0]);
+
+    GtkAllocation allocation;
+    gtk_widget_get_allocation(widget, &allocation);
+    double width = static_cast<double>(allocation.width);
+    double height = static_cast<double>(allocation.height);
+
+    cairo_set_source_rgb(cr, 0.95, 0.95, 0.95);
+    cairo_paint(cr);
+
+    double padding_x = 30;
+    double padding_y = 10;
+    double plot_width = width - 2 * padding_x;
+    double plot_height = height - 2 * padding_y;
+
+    cairo_set_line_width(cr, 0.5);
+    cairo_set_source_rgb(cr, 0.8, 0.8, 0.8);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 9);
+    for (int i = 0; i <= 2; ++i) {
+        double y_grid = padding_y + plot_height * (1.0 - i * 0.5);
+        cairo_move_to(cr, padding_x, y_grid);
+        cairo_line_to(cr, padding_x + plot_width, y_grid);
+        cairo_stroke(cr);
+
+        std::string percent_label = std::to_string(i * 50) + "%";
+        cairo_move_to(cr, 2, y_grid + 3);
+        cairo_show_text(cr, percent_label.c_str());
+    }
+
+    const std::vector<NumaNode>& nodes = numa.nodes();
+    cairo_set_line_width(cr, 1.5);
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        const std::deque<double>& history = memory ? nodes[n].mem_history : nodes[n].cpu_history;
+        if (history.empty()) continue;
+
+        const double* color = NODE_COLORS[n % color_count];
+        cairo_set_source_rgb(cr, color[0], color[1], color[2]);
+        // Newest sample on the right edge, matching the CPU chart once its history is full.
+        size_t offset = max_points > history.size() ? max_points - history.size() : 0;
+        for (size_t i = 0; i < history.size(); ++i) {
+            double x_pos = padding_x + (static_cast<double>(offset + i) / (max_points - 1)) * plot_width;
+            double clamped_value = std::max(0.0, std::min(100.0, history[i]));
+            double y_pos = padding_y + plot_height - (clamped_value / 100.0) * plot_height;
+            if (i == 0) {
+                cairo_move_to(cr, x_pos, y_pos);
+            } else {
+                cairo_line_to(cr, x_pos, y_pos);
+            }
+        }
+        cairo_stroke(cr);
+
+        std::string legend = "node" + std::to_string(nodes[n].id);
+        cairo_move_to(cr, padding_x + 5 + static_cast<double>(n) * 50, padding_y + 10);
+        cairo_show_text(cr, legend.c_str());
+    }
+}
+
+gboolean GUIManager::on_draw_hard_irq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    drawIrqHeatmap(widget, cr, self->sysdata.getHardIrqTable());
+    return FALSE;
+}
+
+gboolean GUIManager::on_draw_soft_irq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    GUIManager* self = static_cast<GUIManager*>(user_data);
+    drawIrqHeatmap(widget, cr, self->sysdata.getSoftIrqTable());
+    return FALSE;
+}
+
+void GUIManager::drawIrqHeatmap(GtkWidget *widget, cairo_t *cr, const IrqTable& table) {
+    GtkAllocation allocation;
+    gtk_widget_get_allocation(widget, &allocation);
+    double width = static_cast<double>(allocation.width);
+    double height = static_cast<double>(allocation.height);
+
+    cairo_set_source_rgb(cr, 0.95, 0.95, 0.95);
+    cairo_paint(cr);
+
+    size_t rows = table.rows();
+    size_t cols = table.cols();
+    if (rows == 0 || cols == 0) {
+        cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+        cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+        cairo_set_font_size(cr, 14);
+        cairo_move_to(cr, width / 2 - 40, height / 2);
+        cairo_show_text(cr, "No data");
+        return;
+    }
+
+    double padding_left = 70;
+    double padding_top = 5;
+    double padding_bottom = 20;
+    double plot_width = width - padding_left - 5;
+    double plot_height = height - padding_top - padding_bottom;
+    if (plot_width <= 0 || plot_height <= 0) {
+        return;
+    }
+
+    // One pixel per IRQ x CPU cell, scaled up with nearest-neighbour filtering: a 256-CPU
+    // table is tens of thousands of cells, far too many to stroke as individual rectangles.
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, static_cast<int>(cols), static_cast<int>(rows));
+    cairo_surface_flush(surface);
+    unsigned char* pixels = cairo_image_surface_get_data(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+
+    const std::vector<uint32_t>& deltas = table.deltas();
+    uint32_t max_delta = deltas.empty() ? 0 : *std::max_element(deltas.begin(), deltas.end());
+    double log_max = std::log1p(static_cast<double>(max_delta));
+
+    for (size_t r = 0; r < rows; ++r) {
+        uint32_t* row_pixels = reinterpret_cast<uint32_t*>(pixels + r * stride);
+        const uint32_t* row_deltas = deltas.data() + r * cols;
+        for (size_t c = 0; c < cols; ++c) {
+            double intensity = log_max > 0 ? std::log1p(static_cast<double>(row_deltas[c])) / log_max : 0.0;
+            double u = intensity < 0.5 ? intensity * 2.0 : (intensity - 0.5) * 2.0;
+            uint32_t red = intensity < 0.5 ? 255 : static_cast<uint32_t>(255.0 - 55.0 * u);
+            uint32_t green = intensity < 0.5 ? static_cast<uint32_t>(255.0 - 35.0 * u) : static_cast<uint32_t>(220.0 * (1.0 - u));
+            uint32_t blue = intensity < 0.5 ? static_cast<uint32_t>(255.0 * (1.0 - u)) : 0;
+            row_pixels[c] = (red << 16) | (green << 8) | blue;
+        }
+    }
+    cairo_surface_mark_dirty(surface);
+
+    cairo_save(cr);
+    cairo_translate(cr, padding_left, padding_top);
+    cairo_scale(cr, plot_width / cols, plot_height / rows);
+    cairo_set_source_surface(cr, surface, 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+    cairo_paint(cr);
+    cairo_restore(cr);
+    cairo_surface_destroy(surface);
+
+    cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 9);
+
+    double row_height = plot_height / rows;
+    if (row_height >= 9) {
+        for (size_t r = 0; r < rows; ++r) {
+            cairo_move_to(cr, 2, padding_top + (r + 1) * row_height - (row_height - 8) / 2);
+            cairo_show_text(cr, table.irqNames()[r].c_str());
+        }
+    }
+
+    double col_width = plot_width / cols;
+    size_t label_step = std::max<size_t>(1, static_cast<size_t>(std::ceil(40.0 / col_width)));
+    for (size_t c = 0; c < cols; c += label_step) {
+        cairo_move_to(cr, padding_left + c * col_width, height - 5);
+        cairo_show_text(cr, table.cpuNames()[c].c_str());
+    }
+
+    char peak_label[48] = "Peak: ";
+    size_t prefix_length = std::strlen(peak_label);
+    char rate_buf[40];
+    size_t rate_length = formatFixed(rate_buf, table.maxRate(), 0, " /s");
+    std::memcpy(peak_label + prefix_length, rate_buf, rate_length);
+    peak_label[prefix_length + rate_length] = '\0';
+    cairo_move_to(cr, 2, height - 5);
+    cairo_show_text(cr, peak_label);
+}
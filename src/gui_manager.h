@@ -4,6 +4,9 @@
 #include <gtk/gtk.h>
 #include "system_data.h"
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <string>
 
 class GUIManager {
 public:
@@ -18,9 +21,39 @@ private:
     GtkWidget* temp_grid_;
     GtkWidget* cpu_mem_grid_;
     GtkWidget* disk_grid_;
+    GtkWidget* irq_grid_;
+    GtkWidget* numa_grid_;
     GtkWidget* settings_grid_;
 
+    int temp_page_;
+    int cpu_mem_page_;
+    int disk_page_;
+    int irq_page_;
+    int numa_page_;
+    unsigned long tick_count_;
+    double last_cpu_usage_;
+
+    // Last text and severity class applied to each label, so unchanged values never touch GTK.
+    struct LabelState {
+        std::string text;
+        int severity = -1;
+    };
+    std::unordered_map<GtkWidget*, LabelState> label_states_;
+
     std::map<std::string, GtkWidget*> templabels;
+    GtkWidget* temp_status_label_;
+    int temp_next_row_;
+
+    GtkWidget* power_status_label_;
+    GtkWidget* cpu_freq_chart_area_;
+    GtkWidget* freq_avg_label_;
+    GtkWidget* freq_min_label_;
+    GtkWidget* freq_max_label_;
+    std::vector<GtkWidget*> rapl_labels_;
+    std::vector<GtkWidget*> idle_state_labels_;
+    int power_next_row_;
+    bool power_rows_built_;
+    double cpu_freq_peak_mhz_;
 
     GtkWidget* cpu_usage_label_;
     GtkWidget* cpu_chart_area_;
@@ -35,19 +68,58 @@ private:
     GtkWidget* disk_free_label_;
     GtkWidget* disk_usage_label_;
 
+    GtkWidget* hard_irq_chart_area_;
+    GtkWidget* soft_irq_chart_area_;
+
+    struct NumaRowLabels {
+        GtkWidget* cpu;
+        GtkWidget* memory;
+        GtkWidget* hit;
+        GtkWidget* miss;
+        GtkWidget* foreign;
+    };
+    GtkWidget* numa_status_label_;
+    GtkWidget* numa_cpu_chart_area_;
+    GtkWidget* numa_mem_chart_area_;
+    std::vector<NumaRowLabels> numa_row_labels_;
+    bool numa_rows_built_;
+
     GtkWidget* update_interval_spin_button_;
     guint timeout_source_id_;
 
     static void activate(GtkApplication* app, gpointer user_data);
     static gboolean update_data_cb(gpointer user_data);
+    static gboolean first_update_cb(gpointer user_data);
+    static gboolean sensors_found_cb(gpointer user_data);
+    static void on_switch_page(GtkNotebook* notebook, GtkWidget* page, guint page_num, gpointer user_data);
     static void on_update_interval_changed(GtkSpinButton* spinner, gpointer user_data);
     static gboolean on_draw_cpu_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static gboolean on_draw_hard_irq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static gboolean on_draw_soft_irq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static gboolean on_draw_cpu_freq_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static gboolean on_draw_numa_cpu_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static gboolean on_draw_numa_mem_chart(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+    static void drawNumaHistory(GtkWidget *widget, cairo_t *cr, const NumaStats& numa, size_t max_points, bool memory);
+    static void drawIrqHeatmap(GtkWidget *widget, cairo_t *cr, const IrqTable& table);
 
     void onActivate(GtkApplication* app);
     gboolean onUpdateData();
 
+    void onSensorsFound();
+    void refreshPage(int page);
+
+    void setLabelText(GtkWidget* label, const char* text, size_t length);
+    void setLabelText(GtkWidget* label, const char* text);
+    void setLabelSeverity(GtkWidget* label, int severity);
+
     void updateTemperatureLabels();
-    void updateCpuUsageLabel();
+    void setTemperatureLabel(GtkWidget* temp_label, double temp_value);
+    GtkWidget* addPowerRow(const std::string& name);
+    void buildCpuPowerRows(const CpuPowerStats& power);
+    void updateCpuPowerLabels();
+    void updateCpuUsageLabel(double cpu_usage);
+    void buildNumaRows(const NumaStats& numa);
+    void updateNumaLabels();
     void updateMemoryLabels();
     void updateDiskLabels();
 };
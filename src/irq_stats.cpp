@@ -0,0 +1,300 @@
+#include "irq_stats.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Slack kept zeroed past the end of the read buffer so the cell and vector loads below never leave the allocation.
+const size_t BUFFER_PADDING = 16;
+const size_t INITIAL_BUFFER_SIZE = 64 * 1024;
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && *p == ' ') ++p;
+    return p;
+}
+
+bool isDigit(char c) {
+    return static_cast<unsigned char>(c - '0') <= 9;
+}
+
+// The kernel prints every counter as " %10u", i.e. 11-byte cells with the digits right-aligned.
+const size_t FIXED_CELL_WIDTH = 11;
+
+// Bit i is set when p[i] is a space or a digit respectively, for i in [0, 12).
+void classifyCell(const char* p, unsigned& spaces, unsigned& digits) {
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    spaces = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '))));
+    digits = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                                                     _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)))));
+#else
+    spaces = 0;
+    digits = 0;
+    for (unsigned i = 0; i < FIXED_CELL_WIDTH + 1; ++i) {
+        spaces |= static_cast<unsigned>(p[i] == ' ') << i;
+        digits |= static_cast<unsigned>(isDigit(p[i])) << i;
+    }
+#endif
+}
+
+// A cell is accepted only if p[0] is a space, p[1..10] is a run of spaces followed by at least one
+// digit, and p[11] is not a digit. Anything else, including a stray character inside the cell, is
+// left to the scalar parser. An accepted cell is converted without branching on its digit count:
+// the low nibble of a space is 0, so the padding reads as leading zeros and p[1..8] go through one
+// SWAR conversion.
+bool parseFixedCell(const char* p, uint32_t& value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    unsigned spaces;
+    unsigned digits;
+    classifyCell(p, spaces, digits);
+    const unsigned cell_mask = (1u << FIXED_CELL_WIDTH) - 1;
+    unsigned leading = spaces & cell_mask;
+    // Every byte of the cell is a space or a digit and the byte after it is not a digit; the spaces
+    // form one run starting at p[0] (`leading & (leading + 1)` is zero only for such a run) that
+    // stops before p[10]. Evaluated without short-circuiting, as one predictable branch.
+    bool valid = ((((spaces | digits) & cell_mask) | (digits & (cell_mask + 1))) == cell_mask) &
+                 ((leading & (leading + 1)) == 0) & (leading - 1 < (cell_mask >> 1));
+    if (!valid) {
+        return false;
+    }
+    uint64_t v;
+    std::memcpy(&v, p + 1, sizeof(v));
+    v &= 0x0F0F0F0F0F0F0F0FULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    value = static_cast<uint32_t>(v * 100 + static_cast<uint64_t>(p[9] & 0x0F) * 10 + static_cast<uint64_t>(p[10] - '0'));
+    return true;
+#else
+    (void)p;
+    (void)value;
+    return false;
+#endif
+}
+
+// Fallback for anything that is not a fixed-width cell. Lines end in '\n' and the buffer is
+// zero-padded, so neither loop needs a bound.
+const char* parseCounter(const char* p, uint32_t& value) {
+    if (parseFixedCell(p, value)) {
+        return p + FIXED_CELL_WIDTH;
+    }
+    while (*p == ' ') ++p;
+    if (!isDigit(*p)) {
+        return nullptr;
+    }
+    uint32_t v = static_cast<uint32_t>(*p++ - '0');
+    while (isDigit(*p)) {
+        v = v * 10 + static_cast<uint32_t>(*p++ - '0');
+    }
+    value = v;
+    return p;
+}
+
+// Unsigned 32-bit subtraction wraps exactly like the kernel's counters.
+void subtractCounters(const uint32_t* current, const uint32_t* previous, uint32_t* out, size_t count) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4) {
+        __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+        __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi32(cur, prev));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = current[i] - previous[i];
+    }
+}
+
+bool sameText(const std::string& stored, const char* begin, const char* end) {
+    size_t len = static_cast<size_t>(end - begin);
+    return stored.size() == len && std::memcmp(stored.data(), begin, len) == 0;
+}
+
+}
+
+IrqTable::IrqTable(const std::string& proc_path)
+    : proc_path_(proc_path), fd_(-1), buffer_(INITIAL_BUFFER_SIZE + BUFFER_PADDING, 0),
+      interval_seconds_(0.0), has_previous_(false) {}
+
+IrqTable::~IrqTable() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool IrqTable::readFile(size_t& length) {
+    if (fd_ < 0) {
+        fd_ = open(proc_path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            std::cerr << "Error opening " << proc_path_ << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+    } else if (lseek(fd_, 0, SEEK_SET) < 0) {
+        std::cerr << "Error rewinding " << proc_path_ << ": " << strerror(errno) << std::endl;
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    length = 0;
+    while (true) {
+        size_t capacity = buffer_.size() - BUFFER_PADDING;
+        if (length == capacity) {
+            buffer_.resize(capacity * 2 + BUFFER_PADDING);
+            capacity = buffer_.size() - BUFFER_PADDING;
+        }
+        ssize_t n = read(fd_, buffer_.data() + length, capacity - length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error reading " << proc_path_ << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        if (n == 0) break;
+        length += static_cast<size_t>(n);
+    }
+    std::memset(buffer_.data() + length, 0, BUFFER_PADDING);
+    return true;
+}
+
+bool IrqTable::parse(const char* data, size_t length) {
+    const char* p = data;
+    const char* end = data + length;
+
+    const char* line_end = static_cast<const char*>(std::memchr(p, '\n', length));
+    if (!line_end) line_end = end;
+
+    bool layout_changed = false;
+    size_t col = 0;
+    while (true) {
+        p = skipSpaces(p, line_end);
+        if (p >= line_end) break;
+        const char* token_end = p;
+        while (token_end < line_end && *token_end != ' ') ++token_end;
+        if (col >= cpu_names_.size()) {
+            cpu_names_.emplace_back(p, token_end);
+            layout_changed = true;
+        } else if (!sameText(cpu_names_[col], p, token_end)) {
+            cpu_names_[col].assign(p, token_end);
+            layout_changed = true;
+        }
+        ++col;
+        p = token_end;
+    }
+    if (col != cpu_names_.size()) {
+        cpu_names_.resize(col);
+        layout_changed = true;
+    }
+    const size_t cols = cpu_names_.size();
+    if (cols == 0) {
+        return false;
+    }
+
+    size_t row = 0;
+    p = line_end + 1;
+    while (p < end) {
+        line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!line_end) line_end = end;
+
+        const char* label = skipSpaces(p, line_end);
+        const char* colon = static_cast<const char*>(std::memchr(label, ':', static_cast<size_t>(line_end - label)));
+        if (!colon) {
+            p = line_end + 1;
+            continue;
+        }
+
+        if (row >= irq_names_.size()) {
+            irq_names_.emplace_back(label, colon);
+            irq_descriptions_.emplace_back();
+            layout_changed = true;
+        } else if (!sameText(irq_names_[row], label, colon)) {
+            irq_names_[row].assign(label, colon);
+            layout_changed = true;
+        }
+
+        if (counts_.size() < (row + 1) * cols) {
+            counts_.resize((row + 1) * cols);
+        }
+        uint32_t* row_counts = counts_.data() + row * cols;
+
+        p = colon + 1;
+        size_t c = 0;
+        for (; c < cols; ++c) {
+            const char* next = parseCounter(p, row_counts[c]);
+            if (!next) break;
+            p = next;
+        }
+        std::fill(row_counts + c, row_counts + cols, 0);
+
+        const char* desc_begin = skipSpaces(p, line_end);
+        const char* desc_end = line_end;
+        while (desc_end > desc_begin && (desc_end[-1] == ' ' || desc_end[-1] == '\r')) --desc_end;
+        if (!sameText(irq_descriptions_[row], desc_begin, desc_end)) {
+            irq_descriptions_[row].assign(desc_begin, desc_end);
+        }
+
+        ++row;
+        p = line_end + 1;
+    }
+
+    if (row != irq_names_.size()) {
+        irq_names_.resize(row);
+        irq_descriptions_.resize(row);
+        layout_changed = true;
+    }
+    counts_.resize(row * cols);
+
+    if (layout_changed) {
+        has_previous_ = false;
+    }
+    return true;
+}
+
+bool IrqTable::update() {
+    size_t length = 0;
+    if (!readFile(length)) {
+        return false;
+    }
+    // The last sample becomes the reference and its old reference buffer is parsed over, so no
+    // matrix is copied per tick.
+    std::swap(prev_counts_, counts_);
+    if (!parse(buffer_.data(), length)) {
+        has_previous_ = false;
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point current_time = std::chrono::steady_clock::now();
+    deltas_.resize(counts_.size());
+    if (has_previous_ && prev_counts_.size() == counts_.size()) {
+        subtractCounters(counts_.data(), prev_counts_.data(), deltas_.data(), counts_.size());
+        interval_seconds_ = std::chrono::duration_cast<std::chrono::duration<double>>(current_time - last_update_time_).count();
+    } else {
+        std::fill(deltas_.begin(), deltas_.end(), 0);
+        interval_seconds_ = 0.0;
+    }
+
+    last_update_time_ = current_time;
+    has_previous_ = true;
+    return true;
+}
+
+double IrqTable::rate(size_t row, size_t col) const {
+    if (interval_seconds_ <= 0.0 || row >= rows() || col >= cols()) {
+        return 0.0;
+    }
+    return static_cast<double>(deltas_[row * cols() + col]) / interval_seconds_;
+}
+
+double IrqTable::maxRate() const {
+    if (interval_seconds_ <= 0.0 || deltas_.empty()) {
+        return 0.0;
+    }
+    return static_cast<double>(*std::max_element(deltas_.begin(), deltas_.end())) / interval_seconds_;
+}
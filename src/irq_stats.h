@@ -0,0 +1,59 @@
+#ifndef IRQ_STATS_H
+#define IRQ_STATS_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// Per-IRQ x per-CPU counter table parsed from /proc/interrupts or /proc/softirqs.
+// Counters and deltas are stored row-major in flat arrays: cell (row, col) lives at row * cols + col.
+// The kernel prints the counters as 32-bit unsigned values, so they are kept as such and deltas
+// wrap modulo 2^32.
+class IrqTable {
+public:
+    explicit IrqTable(const std::string& proc_path);
+    ~IrqTable();
+
+    IrqTable(const IrqTable&) = delete;
+    IrqTable& operator=(const IrqTable&) = delete;
+
+    bool update();
+
+    size_t rows() const { return irq_names_.size(); }
+    size_t cols() const { return cpu_names_.size(); }
+
+    const std::vector<std::string>& irqNames() const { return irq_names_; }
+    const std::vector<std::string>& irqDescriptions() const { return irq_descriptions_; }
+    const std::vector<std::string>& cpuNames() const { return cpu_names_; }
+
+    const std::vector<uint32_t>& counts() const { return counts_; }
+    const std::vector<uint32_t>& deltas() const { return deltas_; }
+
+    double rate(size_t row, size_t col) const;
+    double maxRate() const;
+    double intervalSeconds() const { return interval_seconds_; }
+
+private:
+    std::string proc_path_;
+    int fd_;
+    std::vector<char> buffer_;
+
+    std::vector<std::string> cpu_names_;
+    std::vector<std::string> irq_names_;
+    std::vector<std::string> irq_descriptions_;
+
+    std::vector<uint32_t> counts_;
+    std::vector<uint32_t> prev_counts_;
+    std::vector<uint32_t> deltas_;
+
+    std::chrono::steady_clock::time_point last_update_time_;
+    double interval_seconds_;
+    bool has_previous_;
+
+    bool readFile(size_t& length);
+    bool parse(const char* data, size_t length);
+};
+
+#endif
@@ -1,10 +1,145 @@
 #include "system_data.h"
+#include "fleet_agent.h"
+#include "fleet_aggregator.h"
+#include "fleet_terminal_ui.h"
+#ifdef USE_GTK
 #include "gui_manager.h"
+#else
+#include "terminal_ui.h"
+#endif
+#include <iostream>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<bool> stop_requested(false);
+
+void handleStopSignal(int) {
+    stop_requested = true;
+}
+
+void installStopHandlers() {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = handleStopSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+// One descriptor per agent in aggregator mode, and per-core sysfs files kept open by the collectors:
+// the default soft limit of 1024 is too low for a large fleet or host, so the hard limit is used.
+void raiseDescriptorLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage:\n"
+              << "  " << program << "\n"
+              << "      Interactive monitor for this machine.\n"
+              << "  " << program << " --agent ENDPOINT [--hostname NAME] [--interval SECONDS] [--batch FRAMES]\n"
+              << "      Stream snapshots of this machine to an aggregator.\n"
+              << "  " << program << " --aggregate ENDPOINT\n"
+              << "      Accept agent streams and show a fleet overview.\n"
+              << "ENDPOINT is tcp:HOST:PORT or unix:/path/to/socket.\n";
+}
+
+std::string localHostname() {
+    char name[256] = "";
+    if (gethostname(name, sizeof(name) - 1) != 0 || name[0] == '\0') {
+        return "unknown";
+    }
+    return name;
+}
+
+int runAgent(const StreamEndpoint& endpoint, const std::string& hostname, double interval_seconds, int batch_size) {
+    installStopHandlers();
+    SystemData sys_data;
+    FleetAgent agent(sys_data, endpoint, hostname, static_cast<int>(interval_seconds * 1000.0), batch_size);
+    agent.run(stop_requested);
+    return 0;
+}
+
+int runAggregator(const StreamEndpoint& endpoint) {
+    installStopHandlers();
+    FleetAggregator aggregator(endpoint);
+    if (!aggregator.start()) {
+        return 1;
+    }
+    FleetTerminalUI fleet_ui(aggregator);
+    fleet_ui.run(stop_requested);
+    return 0;
+}
+
+}
 
 int main(int argc, char* argv[]) {
+    std::string agent_spec;
+    std::string aggregate_spec;
+    std::string hostname;
+    double interval_seconds = 1.0;
+    int batch_size = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--agent" && has_value) {
+            agent_spec = argv[++i];
+        } else if (arg == "--aggregate" && has_value) {
+            aggregate_spec = argv[++i];
+        } else if (arg == "--hostname" && has_value) {
+            hostname = argv[++i];
+        } else if (arg == "--interval" && has_value) {
+            interval_seconds = std::atof(argv[++i]);
+        } else if (arg == "--batch" && has_value) {
+            batch_size = std::atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    raiseDescriptorLimit();
+
+    if (!agent_spec.empty() || !aggregate_spec.empty()) {
+        StreamEndpoint endpoint;
+        const std::string& spec = agent_spec.empty() ? aggregate_spec : agent_spec;
+        if (!agent_spec.empty() && !aggregate_spec.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!parseStreamEndpoint(spec, endpoint)) {
+            std::cerr << "Invalid endpoint: " << spec << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!agent_spec.empty()) {
+            if (interval_seconds <= 0.0 || batch_size < 1) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            return runAgent(endpoint, hostname.empty() ? localHostname() : hostname, interval_seconds, batch_size);
+        }
+        return runAggregator(endpoint);
+    }
+
     SystemData sys_data;
+#ifdef USE_GTK
     GUIManager gui_manager(sys_data);
     gui_manager.run();
+#else
+    TerminalUI terminal_ui(sys_data);
+    terminal_ui.run();
+#endif
 
     return 0;
-}
\ No newline at end of file
+}
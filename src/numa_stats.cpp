@@ -0,0 +1,227 @@
+#include "numa_stats.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cctype>
+
+namespace {
+
+// Parses a cpulist such as "0-3,8,10-11".
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        int first;
+        auto result = std::from_chars(p, end, first);
+        if (result.ec != std::errc()) break;
+        int last = first;
+        p = result.ptr;
+        if (p < end && *p == '-') {
+            result = std::from_chars(p + 1, end, last);
+            if (result.ec != std::errc()) break;
+            p = result.ptr;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        if (p < end && *p == ',') ++p;
+        else break;
+    }
+    return cpus;
+}
+
+// Finds "key" in a NUL-terminated buffer and parses the number that follows it.
+bool valueAfterKey(const char* text, const char* end, const char* key, uint64_t& value) {
+    const char* found = std::strstr(text, key);
+    if (!found) return false;
+    const char* p = found + std::strlen(key);
+    while (p < end && (*p == ' ' || *p == ':')) ++p;
+    return std::from_chars(p, end, value).ec == std::errc();
+}
+
+}
+
+NumaStats::NumaStats(const std::string& sysfs_root, size_t max_history_points)
+    : sysfs_root_(sysfs_root), max_history_points_(max_history_points),
+      discovered_(false), has_previous_(false) {}
+
+void NumaStats::discover() {
+    nodes_.clear();
+    node_files_.clear();
+    cpu_to_node_index_.clear();
+
+    std::string node_path = sysfs_root_ + "/devices/system/node/";
+    std::vector<int> node_ids;
+    for (const std::string& name : listDirectory(node_path)) {
+        int node_id;
+        if (parseIndexedName(name, "node", node_id)) node_ids.push_back(node_id);
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    for (int node_id : node_ids) {
+        std::string node_dir = node_path + "node" + std::to_string(node_id) + "/";
+        NumaNode node = {};
+        node.id = node_id;
+        readFirstLine(node_dir + "cpulist", node.cpu_list);
+        node.cpus = parseCpuList(node.cpu_list);
+
+        for (int cpu : node.cpus) {
+            if (cpu >= static_cast<int>(cpu_to_node_index_.size())) {
+                cpu_to_node_index_.resize(static_cast<size_t>(cpu) + 1, -1);
+            }
+            cpu_to_node_index_[static_cast<size_t>(cpu)] = static_cast<int>(nodes_.size());
+        }
+        nodes_.push_back(node);
+        node_files_.push_back({SysfsFile(node_dir + "meminfo"), SysfsFile(node_dir + "numastat")});
+    }
+
+    node_ticks_.assign(nodes_.size(), {0, 0});
+    prev_node_ticks_.assign(nodes_.size(), {0, 0});
+    has_previous_ = false;
+    discovered_ = true;
+}
+
+void NumaStats::update(const char* proc_stat, size_t proc_stat_length) {
+    if (!discovered_) {
+        discover();
+    }
+    if (nodes_.empty()) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point current_time = std::chrono::steady_clock::now();
+    double elapsed_seconds = has_previous_
+        ? std::chrono::duration_cast<std::chrono::duration<double>>(current_time - last_update_time_).count()
+        : 0.0;
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        readNodeMemory(nodes_[i], node_files_[i].meminfo);
+        readNodeCounters(nodes_[i], node_files_[i].numastat, elapsed_seconds);
+    }
+    readCpuTicks(proc_stat, proc_stat_length);
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        NumaNode& node = nodes_[i];
+        if (has_previous_) {
+            // A CPU going offline drops its line from /proc/stat and makes the node sums shrink.
+            const CpuTicks& current = node_ticks_[i];
+            const CpuTicks& previous = prev_node_ticks_[i];
+            bool valid = current.total > previous.total && current.busy >= previous.busy;
+            node.cpu_usage_percent = valid
+                ? static_cast<double>(current.busy - previous.busy) / (current.total - previous.total) * 100.0
+                : 0.0;
+
+            node.cpu_history.push_back(node.cpu_usage_percent);
+            node.mem_history.push_back(node.mem_usage_percent);
+            while (node.cpu_history.size() > max_history_points_) node.cpu_history.pop_front();
+            while (node.mem_history.size() > max_history_points_) node.mem_history.pop_front();
+        }
+    }
+
+    prev_node_ticks_.swap(node_ticks_);
+    last_update_time_ = current_time;
+    has_previous_ = true;
+}
+
+void NumaStats::readNodeMemory(NumaNode& node, const SysfsFile& file) {
+    size_t length;
+    if (!file.readAll(buffer_, length)) {
+        node.mem_total_kb = -1;
+        node.mem_free_kb = 0;
+        node.mem_used_kb = 0;
+        node.mem_usage_percent = 0.0;
+        return;
+    }
+    const char* text = buffer_.data();
+    const char* end = text + length;
+    uint64_t total = 0;
+    uint64_t free = 0;
+    uint64_t file_pages = 0;
+    uint64_t slab_reclaimable = 0;
+    valueAfterKey(text, end, "MemTotal:", total);
+    valueAfterKey(text, end, "MemFree:", free);
+    valueAfterKey(text, end, "FilePages:", file_pages);
+    valueAfterKey(text, end, "SReclaimable:", slab_reclaimable);
+
+    // Nodes have no MemAvailable line; reclaimable memory is added back the way the kernel does for
+    // the system-wide value (minus its watermark reserves, which are not reported per node).
+    uint64_t available = std::min(total, free + file_pages + slab_reclaimable);
+    node.mem_total_kb = static_cast<long>(total);
+    node.mem_free_kb = static_cast<long>(free);
+    node.mem_used_kb = static_cast<long>(total - available);
+    node.mem_usage_percent = total > 0 ? static_cast<double>(node.mem_used_kb) / node.mem_total_kb * 100.0 : 0.0;
+}
+
+void NumaStats::readNodeCounters(NumaNode& node, const SysfsFile& file, double elapsed_seconds) {
+    size_t length;
+    if (!file.readAll(buffer_, length)) {
+        return;
+    }
+    const char* text = buffer_.data();
+    const char* end = text + length;
+    uint64_t hit = node.numa_hit;
+    uint64_t miss = node.numa_miss;
+    uint64_t foreign = node.numa_foreign;
+    valueAfterKey(text, end, "numa_hit", hit);
+    valueAfterKey(text, end, "numa_miss", miss);
+    valueAfterKey(text, end, "numa_foreign", foreign);
+
+    if (elapsed_seconds > 0.0) {
+        node.hit_per_second = hit >= node.numa_hit ? (hit - node.numa_hit) / elapsed_seconds : 0.0;
+        node.miss_per_second = miss >= node.numa_miss ? (miss - node.numa_miss) / elapsed_seconds : 0.0;
+        node.foreign_per_second = foreign >= node.numa_foreign ? (foreign - node.numa_foreign) / elapsed_seconds : 0.0;
+    }
+    node.numa_hit = hit;
+    node.numa_miss = miss;
+    node.numa_foreign = foreign;
+}
+
+void NumaStats::readCpuTicks(const char* proc_stat, size_t length) {
+    std::fill(node_ticks_.begin(), node_ticks_.end(), CpuTicks{0, 0});
+
+    const char* p = proc_stat;
+    const char* end = p + length;
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!line_end) line_end = end;
+
+        if (line_end - p < 4 || std::memcmp(p, "cpu", 3) != 0) {
+            // The per-CPU lines come first; everything after them is irrelevant here.
+            break;
+        }
+        if (std::isdigit(static_cast<unsigned char>(p[3]))) {
+            int cpu;
+            auto result = std::from_chars(p + 3, line_end, cpu);
+            const char* q = result.ptr;
+            uint64_t fields[10] = {};
+            for (int i = 0; i < 10 && q < line_end; ++i) {
+                while (q < line_end && *q == ' ') ++q;
+                result = std::from_chars(q, line_end, fields[i]);
+                if (result.ec != std::errc()) break;
+                q = result.ptr;
+            }
+
+            // Summed exactly like SystemData's "cpu" line, guest columns included, so that the node
+            // figures and the system figure agree on a single-node machine.
+            uint64_t total = 0;
+            for (uint64_t field : fields) total += field;
+            uint64_t idle = fields[3] + fields[4];
+
+            if (cpu >= 0 && cpu < static_cast<int>(cpu_to_node_index_.size())) {
+                int node_index = cpu_to_node_index_[static_cast<size_t>(cpu)];
+                if (node_index >= 0) {
+                    node_ticks_[static_cast<size_t>(node_index)].total += total;
+                    node_ticks_[static_cast<size_t>(node_index)].busy += total - idle;
+                }
+            }
+        }
+        p = line_end + 1;
+    }
+}
+
+int NumaStats::nodeOfCpu(int cpu) const {
+    if (cpu < 0 || cpu >= static_cast<int>(cpu_to_node_index_.size())) return -1;
+    int node_index = cpu_to_node_index_[static_cast<size_t>(cpu)];
+    return node_index >= 0 ? nodes_[static_cast<size_t>(node_index)].id : -1;
+}
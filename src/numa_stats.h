@@ -0,0 +1,85 @@
+#ifndef NUMA_STATS_H
+#define NUMA_STATS_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include "sysfs_file.h"
+
+struct NumaNode {
+    int id;
+    std::string cpu_list;  // As in the node's cpulist file, e.g. "0-15,32-47".
+    std::vector<int> cpus;
+
+    long mem_total_kb;  // -1 when the node's meminfo could not be read.
+    long mem_free_kb;
+    // Like the system figure, page cache and reclaimable slab count as available rather than used.
+    long mem_used_kb;
+    double mem_usage_percent;
+    double cpu_usage_percent;
+
+    // Cumulative numastat counters (pages) and their rates over the last interval.
+    uint64_t numa_hit;
+    uint64_t numa_miss;
+    uint64_t numa_foreign;
+    double hit_per_second;
+    double miss_per_second;
+    double foreign_per_second;
+
+    std::deque<double> cpu_history;
+    std::deque<double> mem_history;
+};
+
+// Per-node memory, numastat counters and CPU usage from /sys/devices/system/node and /proc/stat.
+// Every node file is opened by discover() and read with pread(). /proc/stat is read by the caller,
+// which also derives the system CPU usage from it, and passed to update().
+class NumaStats {
+public:
+    NumaStats(const std::string& sysfs_root, size_t max_history_points);
+
+    void discover();
+    bool isDiscovered() const { return discovered_; }
+    void update(const char* proc_stat, size_t proc_stat_length);
+
+    // False when the kernel exposes no node directory (e.g. CONFIG_NUMA is off).
+    bool isAvailable() const { return !nodes_.empty(); }
+    bool isMultiNode() const { return nodes_.size() > 1; }
+    const std::vector<NumaNode>& nodes() const { return nodes_; }
+
+    // Node id owning the CPU, or -1 when the CPU belongs to no node.
+    int nodeOfCpu(int cpu) const;
+
+private:
+    struct NodeFiles {
+        SysfsFile meminfo;
+        SysfsFile numastat;
+    };
+
+    struct CpuTicks {
+        uint64_t busy;
+        uint64_t total;
+    };
+
+    std::string sysfs_root_;
+    size_t max_history_points_;
+    bool discovered_;
+
+    std::vector<NumaNode> nodes_;
+    std::vector<NodeFiles> node_files_;
+    std::vector<int> cpu_to_node_index_;  // Indexed by CPU id, -1 for CPUs outside every node.
+
+    std::vector<char> buffer_;
+    std::vector<CpuTicks> node_ticks_;
+    std::vector<CpuTicks> prev_node_ticks_;
+
+    std::chrono::steady_clock::time_point last_update_time_;
+    bool has_previous_;
+
+    void readNodeMemory(NumaNode& node, const SysfsFile& file);
+    void readNodeCounters(NumaNode& node, const SysfsFile& file, double elapsed_seconds);
+    void readCpuTicks(const char* proc_stat, size_t length);
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "snapshot_stream.h"
+#include <cstring>
+
+namespace {
+
+// A keyframe is forced periodically so a stream can be inspected from any point with bounded effort.
+const unsigned KEYFRAME_INTERVAL = 60;
+const size_t FRAME_HEADER_SIZE = 5;
+const uint32_t MAX_FRAME_PAYLOAD = 1024 * 1024;
+
+uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putSigned(std::vector<uint8_t>& out, int64_t value) {
+    putVarint(out, zigzagEncode(value));
+}
+
+void putString(std::vector<uint8_t>& out, const std::string& value) {
+    putVarint(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+class PayloadReader {
+public:
+    PayloadReader(const uint8_t* data, size_t length) : p_(data), end_(data + length), ok_(true) {}
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return p_ == end_; }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p_ >= end_) break;
+            uint8_t byte = *p_++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    int64_t signedVarint() { return zigzagDecode(varint()); }
+
+    std::string string() {
+        uint64_t length = varint();
+        if (!ok_ || length > static_cast<uint64_t>(end_ - p_)) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string value(reinterpret_cast<const char*>(p_), static_cast<size_t>(length));
+        p_ += length;
+        return value;
+    }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_;
+};
+
+}
+
+SnapshotEncoder::SnapshotEncoder() : have_reference_(false), frames_since_keyframe_(0) {}
+
+void SnapshotEncoder::encode(const HostSnapshot& snapshot, const std::string& hostname, std::vector<uint8_t>& out) {
+    bool keyframe = !have_reference_ ||
+                    frames_since_keyframe_ >= KEYFRAME_INTERVAL ||
+                    snapshot.sensor_names != reference_.sensor_names;
+
+    size_t header_offset = out.size();
+    out.resize(out.size() + FRAME_HEADER_SIZE);
+    out[header_offset + 4] = keyframe ? FRAME_KEYFRAME : FRAME_DELTA;
+
+    putVarint(out, snapshot.sequence);
+    if (keyframe) {
+        putString(out, hostname);
+        putVarint(out, SNAPSHOT_FIELD_COUNT);
+        for (size_t i = 0; i < SNAPSHOT_FIELD_COUNT; ++i) {
+            putSigned(out, snapshot.fields[i]);
+        }
+        putVarint(out, snapshot.sensor_names.size());
+        for (size_t i = 0; i < snapshot.sensor_names.size(); ++i) {
+            putString(out, snapshot.sensor_names[i]);
+            putSigned(out, snapshot.temperatures_centi[i]);
+        }
+        frames_since_keyframe_ = 0;
+    } else {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < SNAPSHOT_FIELD_COUNT; ++i) {
+            if (snapshot.fields[i] != reference_.fields[i]) mask |= 1ULL << i;
+        }
+        putVarint(out, mask);
+        for (size_t i = 0; i < SNAPSHOT_FIELD_COUNT; ++i) {
+            if (mask & (1ULL << i)) putSigned(out, snapshot.fields[i] - reference_.fields[i]);
+        }
+
+        size_t changed = 0;
+        for (size_t i = 0; i < snapshot.temperatures_centi.size(); ++i) {
+            if (snapshot.temperatures_centi[i] != reference_.temperatures_centi[i]) ++changed;
+        }
+        putVarint(out, changed);
+        for (size_t i = 0; i < snapshot.temperatures_centi.size(); ++i) {
+            if (snapshot.temperatures_centi[i] != reference_.temperatures_centi[i]) {
+                putVarint(out, i);
+                putSigned(out, snapshot.temperatures_centi[i] - reference_.temperatures_centi[i]);
+            }
+        }
+        ++frames_since_keyframe_;
+    }
+
+    uint32_t payload_length = static_cast<uint32_t>(out.size() - header_offset - FRAME_HEADER_SIZE);
+    for (int i = 0; i < 4; ++i) {
+        out[header_offset + i] = static_cast<uint8_t>(payload_length >> (8 * i));
+    }
+
+    reference_ = snapshot;
+    have_reference_ = true;
+}
+
+SnapshotDecoder::SnapshotDecoder() : has_snapshot_(false), frames_decoded_(0) {}
+
+int SnapshotDecoder::feed(const uint8_t* data, size_t length, const std::function<void(const HostSnapshot&)>& on_frame) {
+    pending_.insert(pending_.end(), data, data + length);
+
+    int applied = 0;
+    size_t offset = 0;
+    while (pending_.size() - offset >= FRAME_HEADER_SIZE) {
+        const uint8_t* header = pending_.data() + offset;
+        uint32_t payload_length = static_cast<uint32_t>(header[0]) | (static_cast<uint32_t>(header[1]) << 8) |
+                                  (static_cast<uint32_t>(header[2]) << 16) | (static_cast<uint32_t>(header[3]) << 24);
+        if (payload_length > MAX_FRAME_PAYLOAD) {
+            return -1;
+        }
+        if (pending_.size() - offset - FRAME_HEADER_SIZE < payload_length) {
+            break;
+        }
+        if (!applyFrame(header[4], header + FRAME_HEADER_SIZE, payload_length)) {
+            return -1;
+        }
+        offset += FRAME_HEADER_SIZE + payload_length;
+        ++applied;
+        if (on_frame) on_frame(snapshot_);
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(offset));
+    return applied;
+}
+
+bool SnapshotDecoder::applyFrame(uint8_t type, const uint8_t* payload, size_t length) {
+    PayloadReader reader(payload, length);
+
+    if (type == FRAME_KEYFRAME) {
+        HostSnapshot snapshot;
+        snapshot.sequence = reader.varint();
+        std::string hostname = reader.string();
+        uint64_t field_count = reader.varint();
+        for (uint64_t i = 0; i < field_count && reader.ok(); ++i) {
+            int64_t value = reader.signedVarint();
+            // Fields added by newer agents are skipped.
+            if (i < SNAPSHOT_FIELD_COUNT) snapshot.fields[i] = value;
+        }
+        uint64_t sensor_count = reader.varint();
+        if (!reader.ok() || sensor_count > length) return false;
+        snapshot.sensor_names.reserve(static_cast<size_t>(sensor_count));
+        snapshot.temperatures_centi.reserve(static_cast<size_t>(sensor_count));
+        for (uint64_t i = 0; i < sensor_count && reader.ok(); ++i) {
+            snapshot.sensor_names.push_back(reader.string());
+            snapshot.temperatures_centi.push_back(reader.signedVarint());
+        }
+        if (!reader.ok() || !reader.atEnd()) return false;
+
+        snapshot_ = std::move(snapshot);
+        hostname_ = std::move(hostname);
+        has_snapshot_ = true;
+    } else if (type == FRAME_DELTA) {
+        if (!has_snapshot_) return false;
+
+        HostSnapshot& snapshot = snapshot_;
+        uint64_t sequence = reader.varint();
+        uint64_t mask = reader.varint();
+        int64_t fields[SNAPSHOT_FIELD_COUNT];
+        std::memcpy(fields, snapshot.fields, sizeof(fields));
+        for (size_t i = 0; i < 64 && reader.ok(); ++i) {
+            if ((mask & (1ULL << i)) == 0) continue;
+            int64_t delta = reader.signedVarint();
+            // Fields added by newer agents are skipped, as in keyframes.
+            if (i < SNAPSHOT_FIELD_COUNT) fields[i] += delta;
+        }
+        uint64_t changed = reader.varint();
+        if (!reader.ok() || changed > snapshot.temperatures_centi.size()) return false;
+        for (uint64_t i = 0; i < changed; ++i) {
+            uint64_t index = reader.varint();
+            int64_t delta = reader.signedVarint();
+            if (!reader.ok() || index >= snapshot.temperatures_centi.size()) return false;
+            snapshot.temperatures_centi[static_cast<size_t>(index)] += delta;
+        }
+        if (!reader.ok() || !reader.atEnd()) return false;
+
+        snapshot.sequence = sequence;
+        std::memcpy(snapshot.fields, fields, sizeof(fields));
+    } else {
+        return false;
+    }
+
+    ++frames_decoded_;
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOT_STREAM_H
+#define SNAPSHOT_STREAM_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// Wire format shared by the agent and the aggregator.
+//
+// Every frame is: u32 payload length (little-endian), u8 frame type, payload.
+// A keyframe carries the hostname, the sensor names and every value (as zigzag varint deltas from 0).
+// A delta frame carries a bitmask of the scalar fields that changed, their zigzag varint deltas, and a
+// sparse list of (sensor index, delta) pairs for temperatures that changed. Deltas are always relative
+// to the previous frame on the same connection, so a connection must start with a keyframe.
+//
+// New scalar fields are only ever appended to SnapshotField. Every field is a single zigzag varint in
+// both frame types, so a decoder skips the values of fields it does not know: the keyframe carries the
+// field count and each set mask bit in a delta frame is followed by exactly one value. Anything that is
+// not a scalar field needs a new frame type, which older decoders reject along with the connection.
+
+enum SnapshotField {
+    FIELD_TIMESTAMP_MS,
+    FIELD_CPU_PERMILLE,
+    FIELD_MEM_TOTAL_KB,
+    FIELD_MEM_USED_KB,
+    FIELD_MEM_AVAILABLE_KB,
+    FIELD_DISK_TOTAL_GB,
+    FIELD_DISK_USED_GB,
+    SNAPSHOT_FIELD_COUNT
+};
+
+enum SnapshotFrameType : uint8_t {
+    FRAME_KEYFRAME = 1,
+    FRAME_DELTA = 2
+};
+
+struct HostSnapshot {
+    uint64_t sequence = 0;
+    int64_t fields[SNAPSHOT_FIELD_COUNT] = {};
+    std::vector<std::string> sensor_names;
+    // Hundredths of a degree Celsius, -100 when the sensor could not be read.
+    std::vector<int64_t> temperatures_centi;
+};
+
+class SnapshotEncoder {
+public:
+    SnapshotEncoder();
+
+    // Appends one frame describing `snapshot` to `out`.
+    void encode(const HostSnapshot& snapshot, const std::string& hostname, std::vector<uint8_t>& out);
+
+    // Forces the next frame to be a keyframe, e.g. after a reconnect or after frames were dropped.
+    void requestKeyframe() { have_reference_ = false; }
+
+private:
+    HostSnapshot reference_;
+    bool have_reference_;
+    unsigned frames_since_keyframe_;
+};
+
+class SnapshotDecoder {
+public:
+    SnapshotDecoder();
+
+    // Consumes bytes from the stream and returns the number of complete frames applied,
+    // or -1 on a malformed frame, in which case the connection should be dropped.
+    // on_frame, if set, sees the snapshot after each applied frame (batched frames arrive together).
+    int feed(const uint8_t* data, size_t length, const std::function<void(const HostSnapshot&)>& on_frame = nullptr);
+
+    bool hasSnapshot() const { return has_snapshot_; }
+    const HostSnapshot& snapshot() const { return snapshot_; }
+    const std::string& hostname() const { return hostname_; }
+    uint64_t framesDecoded() const { return frames_decoded_; }
+
+private:
+    std::vector<uint8_t> pending_;
+    HostSnapshot snapshot_;
+    std::string hostname_;
+    bool has_snapshot_;
+    uint64_t frames_decoded_;
+
+    bool applyFrame(uint8_t type, const uint8_t* payload, size_t length);
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "stream_endpoint.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const int LISTEN_BACKLOG = 1024;
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// connect() on a non-blocking socket, waiting at most timeout_ms for it to complete. A signal
+// (e.g. SIGINT) ends the wait early. On failure errno describes the error.
+bool connectWithTimeout(int fd, const sockaddr* address, socklen_t address_length, int timeout_ms) {
+    if (connect(fd, address, address_length) == 0) return true;
+    if (errno != EINPROGRESS) return false;
+
+    pollfd pfd = {fd, POLLOUT, 0};
+    int ready = poll(&pfd, 1, timeout_ms);
+    if (ready < 0) return false;
+    if (ready == 0) {
+        errno = ETIMEDOUT;
+        return false;
+    }
+    int error = 0;
+    socklen_t error_length = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length) != 0) return false;
+    if (error != 0) {
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+bool fillUnixAddress(const StreamEndpoint& endpoint, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (endpoint.path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Unix socket path too long: " << endpoint.path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, endpoint.path.c_str(), endpoint.path.size() + 1);
+    return true;
+}
+
+addrinfo* resolveTcp(const StreamEndpoint& endpoint, bool passive) {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+
+    addrinfo* result = nullptr;
+    const char* host = endpoint.host.empty() || endpoint.host == "*" ? nullptr : endpoint.host.c_str();
+    int rc = getaddrinfo(host, endpoint.port.c_str(), &hints, &result);
+    if (rc != 0) {
+        std::cerr << "Could not resolve " << endpoint.describe() << ": " << gai_strerror(rc) << std::endl;
+        return nullptr;
+    }
+    return result;
+}
+
+}
+
+std::string StreamEndpoint::describe() const {
+    if (kind == UNIX) return "unix:" + path;
+    return "tcp:" + host + ":" + port;
+}
+
+bool parseStreamEndpoint(const std::string& spec, StreamEndpoint& endpoint) {
+    if (spec.rfind("unix:", 0) == 0) {
+        endpoint.kind = StreamEndpoint::UNIX;
+        endpoint.path = spec.substr(5);
+        return !endpoint.path.empty();
+    }
+    if (spec.rfind("tcp:", 0) == 0) {
+        std::string rest = spec.substr(4);
+        size_t colon = rest.rfind(':');
+        if (colon == std::string::npos || colon + 1 == rest.size()) return false;
+        endpoint.kind = StreamEndpoint::TCP;
+        endpoint.host = rest.substr(0, colon);
+        endpoint.port = rest.substr(colon + 1);
+        // Allow "[::1]" style IPv6 literals.
+        if (endpoint.host.size() >= 2 && endpoint.host.front() == '[' && endpoint.host.back() == ']') {
+            endpoint.host = endpoint.host.substr(1, endpoint.host.size() - 2);
+        }
+        return true;
+    }
+    return false;
+}
+
+int connectStreamEndpoint(const StreamEndpoint& endpoint, int timeout_ms) {
+    if (endpoint.kind == StreamEndpoint::UNIX) {
+        sockaddr_un address;
+        if (!fillUnixAddress(endpoint, address)) return -1;
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            std::cerr << "Error creating socket: " << strerror(errno) << std::endl;
+            return -1;
+        }
+        if (!connectWithTimeout(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address), timeout_ms)) {
+            std::cerr << "Error connecting to " << endpoint.describe() << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    addrinfo* addresses = resolveTcp(endpoint, false);
+    if (!addresses) return -1;
+
+    int fd = -1;
+    int last_errno = 0;
+    for (addrinfo* ai = addresses; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            last_errno = errno;
+            continue;
+        }
+        if (connectWithTimeout(fd, ai->ai_addr, ai->ai_addrlen, timeout_ms)) {
+            break;
+        }
+        last_errno = errno;
+        close(fd);
+        fd = -1;
+        if (last_errno == EINTR) break;
+    }
+    freeaddrinfo(addresses);
+
+    if (fd < 0) {
+        std::cerr << "Error connecting to " << endpoint.describe() << ": " << strerror(last_errno) << std::endl;
+    }
+    return fd;
+}
+
+int listenStreamEndpoint(const StreamEndpoint& endpoint) {
+    if (endpoint.kind == StreamEndpoint::UNIX) {
+        sockaddr_un address;
+        if (!fillUnixAddress(endpoint, address)) return -1;
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            std::cerr << "Error creating socket: " << strerror(errno) << std::endl;
+            return -1;
+        }
+        unlink(endpoint.path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(fd, LISTEN_BACKLOG) != 0 || !setNonBlocking(fd)) {
+            std::cerr << "Error listening on " << endpoint.describe() << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    addrinfo* addresses = resolveTcp(endpoint, true);
+    if (!addresses) return -1;
+
+    int fd = -1;
+    int last_errno = 0;
+    for (addrinfo* ai = addresses; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            last_errno = errno;
+            continue;
+        }
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, LISTEN_BACKLOG) == 0 && setNonBlocking(fd)) {
+            break;
+        }
+        last_errno = errno;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+
+    if (fd < 0) {
+        std::cerr << "Error listening on " << endpoint.describe() << ": " << strerror(last_errno) << std::endl;
+    }
+    return fd;
+}
@@ -0,0 +1,25 @@
+#ifndef STREAM_ENDPOINT_H
+#define STREAM_ENDPOINT_H
+
+#include <string>
+
+// A TCP or Unix stream socket address, written as "tcp:HOST:PORT" or "unix:/path/to/socket".
+struct StreamEndpoint {
+    enum Kind { TCP, UNIX };
+
+    Kind kind = TCP;
+    std::string host;
+    std::string port;
+    std::string path;
+
+    std::string describe() const;
+};
+
+bool parseStreamEndpoint(const std::string& spec, StreamEndpoint& endpoint);
+
+// Both return a non-blocking socket, or -1 after logging the error to std::cerr.
+// connectStreamEndpoint gives up after timeout_ms per address, or as soon as a signal arrives.
+int connectStreamEndpoint(const StreamEndpoint& endpoint, int timeout_ms);
+int listenStreamEndpoint(const StreamEndpoint& endpoint);
+
+#endif
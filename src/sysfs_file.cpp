@@ -0,0 +1,86 @@
+#include "sysfs_file.h"
+#include <fstream>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+SysfsFile::SysfsFile(const std::string& path) : fd_(open(path.c_str(), O_RDONLY | O_CLOEXEC)) {}
+
+SysfsFile::~SysfsFile() {
+    if (fd_ >= 0) close(fd_);
+}
+
+SysfsFile::SysfsFile(SysfsFile&& other) noexcept : fd_(other.fd_) {
+    other.fd_ = -1;
+}
+
+SysfsFile& SysfsFile::operator=(SysfsFile&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) close(fd_);
+        fd_ = other.fd_;
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+bool SysfsFile::readInteger(uint64_t& value) const {
+    if (fd_ < 0) return false;
+    char buf[32];
+    ssize_t n = pread(fd_, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    auto result = std::from_chars(buf, buf + n, value);
+    return result.ec == std::errc();
+}
+
+bool SysfsFile::readAll(std::vector<char>& buffer, size_t& length) const {
+    length = 0;
+    if (fd_ < 0) return false;
+    if (buffer.size() < 4096) buffer.resize(4096);
+
+    while (true) {
+        if (length + 1 >= buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t n = pread(fd_, buffer.data() + length, buffer.size() - length - 1, static_cast<off_t>(length));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) break;
+        length += static_cast<size_t>(n);
+    }
+    buffer[length] = '\0';
+    return true;
+}
+
+std::vector<std::string> listDirectory(const std::string& path) {
+    std::vector<std::string> entries;
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return entries;
+    dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") entries.push_back(name);
+    }
+    closedir(dir);
+    return entries;
+}
+
+bool readFirstLine(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::getline(file, line);
+    return true;
+}
+
+bool parseIndexedName(const std::string& name, const char* prefix, int& index) {
+    size_t prefix_length = std::strlen(prefix);
+    if (name.size() <= prefix_length || name.compare(0, prefix_length, prefix) != 0) return false;
+    const char* begin = name.data() + prefix_length;
+    const char* end = name.data() + name.size();
+    auto result = std::from_chars(begin, end, index);
+    return result.ec == std::errc() && result.ptr == end;
+}
@@ -0,0 +1,37 @@
+#ifndef SYSFS_FILE_H
+#define SYSFS_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// A sysfs (or procfs) file opened once and re-read with pread() from offset 0 on every tick,
+// which makes the kernel regenerate its contents without a fresh open()/close() pair.
+class SysfsFile {
+public:
+    SysfsFile() : fd_(-1) {}
+    explicit SysfsFile(const std::string& path);
+    ~SysfsFile();
+
+    SysfsFile(SysfsFile&& other) noexcept;
+    SysfsFile& operator=(SysfsFile&& other) noexcept;
+    SysfsFile(const SysfsFile&) = delete;
+    SysfsFile& operator=(const SysfsFile&) = delete;
+
+    bool isOpen() const { return fd_ >= 0; }
+    bool readInteger(uint64_t& value) const;
+    // Reads the whole file into buffer, growing it as needed; the contents are NUL-terminated.
+    bool readAll(std::vector<char>& buffer, size_t& length) const;
+
+private:
+    int fd_;
+};
+
+std::vector<std::string> listDirectory(const std::string& path);
+bool readFirstLine(const std::string& path, std::string& line);
+
+// Matches entries such as "cpu12" or "node1" and extracts the number.
+bool parseIndexedName(const std::string& name, const char* prefix, int& index);
+
+#endif
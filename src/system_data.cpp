@@ -8,18 +8,70 @@
 #include <limits>
 #include <sys/statvfs.h> 
 #include <cstring> 
+#include <cstdlib>
 #include <cerrno> 
 
-SystemData::SystemData() {
-    initializeSensors();
+SystemData::SystemData(const std::string& sysfs_root)
+    : sysfs_root_(sysfs_root), sensor_discovery_done_(false),
+      proc_stat_("/proc/stat"), proc_stat_length_(0),
+      hard_irqs_("/proc/interrupts"), soft_irqs_("/proc/softirqs"),
+      cpu_power_(sysfs_root), numa_(sysfs_root, MAX_HISTORY_POINTS) {
     prev_cpu_stats_ = readCpuStats();
     last_cpu_update_time_ = std::chrono::steady_clock::now();
 }
 
-void SystemData::initializeSensors() {
+SystemData::~SystemData() {
+    if (sensor_discovery_thread_.joinable()) {
+        sensor_discovery_thread_.join();
+    }
+}
+
+void SystemData::discoverSensors() {
+    sensors_.clear();
+    findHwmonSensors([this](std::vector<SensorInfo>& chip_sensors) {
+        sensors_.insert(sensors_.end(), chip_sensors.begin(), chip_sensors.end());
+    });
+    sensor_discovery_done_ = true;
+}
+
+void SystemData::startSensorDiscovery(std::function<void()> on_sensors_found) {
+    if (sensor_discovery_thread_.joinable()) {
+        return;
+    }
     sensors_.clear();
-    findHwmonSensors();
-    // TODO: Add more sophisticated logic for CPU/GPU detection if needed
+    sensor_discovery_done_ = false;
+    sensor_discovery_thread_ = std::thread([this, on_sensors_found]() {
+        findHwmonSensors([this, &on_sensors_found](std::vector<SensorInfo>& chip_sensors) {
+            std::vector<std::pair<SensorInfo, double>> readings;
+            readings.reserve(chip_sensors.size());
+            for (const auto& sensor : chip_sensors) {
+                readings.emplace_back(sensor, readTemperatureFromFile(sensor.path));
+            }
+            {
+                std::lock_guard<std::mutex> lock(pending_sensors_mutex_);
+                pending_sensors_.insert(pending_sensors_.end(), readings.begin(), readings.end());
+            }
+            if (on_sensors_found) on_sensors_found();
+        });
+        // Opening a file per core and idle state takes tens of milliseconds on large machines.
+        cpu_power_.discover();
+        sensor_discovery_done_ = true;
+        if (on_sensors_found) on_sensors_found();
+    });
+}
+
+std::map<std::string, double> SystemData::takeDiscoveredSensors() {
+    std::vector<std::pair<SensorInfo, double>> discovered;
+    {
+        std::lock_guard<std::mutex> lock(pending_sensors_mutex_);
+        discovered.swap(pending_sensors_);
+    }
+    std::map<std::string, double> readings;
+    for (const auto& pair : discovered) {
+        sensors_.push_back(pair.first);
+        readings[pair.first.name] = pair.second;
+    }
+    return readings;
 }
 
 double SystemData::readTemperatureFromFile(const std::string& filepath) {
@@ -75,8 +127,8 @@ std::map<std::string, double> SystemData::getAllTemperatures() {
     return all_temps;
 }
 
-void SystemData::findHwmonSensors() {
-    std::string hwmon_path = "/sys/class/hwmon/";
+void SystemData::findHwmonSensors(const std::function<void(std::vector<SensorInfo>&)>& on_chip_found) {
+    std::string hwmon_path = sysfs_root_ + "/class/hwmon/";
     DIR* dir = opendir(hwmon_path.c_str());
     if (!dir) {
         std::cerr << "Could not open " << hwmon_path << std::endl;
@@ -102,6 +154,7 @@ void SystemData::findHwmonSensors() {
         DIR* sensor_dir = opendir(full_hwmon_path.c_str());
         if (!sensor_dir) continue;
 
+        std::vector<SensorInfo> chip_sensors;
         dirent* sensor_entry;
         while ((sensor_entry = readdir(sensor_dir)) != NULL) {
             std::string filename = sensor_entry->d_name;
@@ -116,31 +169,37 @@ void SystemData::findHwmonSensors() {
                 } else {
                     info.name = chip_name + " " + filename.substr(0, filename.length() - 6);
                 }
-                sensors_.push_back(info);
+                chip_sensors.push_back(info);
             }
         }
         closedir(sensor_dir);
+
+        if (!chip_sensors.empty()) {
+            on_chip_found(chip_sensors);
+        }
     }
     closedir(dir);
 }
 
 CpuStats SystemData::readCpuStats() {
     CpuStats current_stats = {0};
-    std::ifstream file("/proc/stat");
-    if (!file.is_open()) {
+    proc_stat_length_ = 0;
+    if (!proc_stat_.readAll(proc_stat_buffer_, proc_stat_length_)) {
         std::cerr << "Error opening /proc/stat" << std::endl;
         return current_stats;
     }
 
-    std::string line;
-    std::getline(file, line);
-    file.close();
-
-    std::stringstream ss(line);
-    std::string cpu_label;
-    ss >> cpu_label >> current_stats.user >> current_stats.nice >> current_stats.system >> current_stats.idle
-       >> current_stats.iowait >> current_stats.irq >> current_stats.softirq >> current_stats.steal
-       >> current_stats.guest >> current_stats.guest_nice;
+    // The whole file is kept for updateNumaStats(); only the aggregate "cpu" line is parsed here.
+    char* p = proc_stat_buffer_.data();
+    if (std::strncmp(p, "cpu ", 4) == 0) {
+        long* fields[] = {&current_stats.user, &current_stats.nice, &current_stats.system, &current_stats.idle,
+                          &current_stats.iowait, &current_stats.irq, &current_stats.softirq, &current_stats.steal,
+                          &current_stats.guest, &current_stats.guest_nice};
+        p += 4;
+        for (long* field : fields) {
+            *field = std::strtol(p, &p, 10);
+        }
+    }
 
     current_stats.total = current_stats.user + current_stats.nice + current_stats.system + current_stats.idle +
                           current_stats.iowait + current_stats.irq + current_stats.softirq + current_stats.steal +
@@ -174,6 +233,31 @@ double SystemData::getCpuUsage() {
     return cpu_usage;
 }
 
+void SystemData::updateInterruptStats() {
+    hard_irqs_.update();
+    soft_irqs_.update();
+}
+
+bool SystemData::updateCpuPowerStats() {
+    if (!isCpuPowerStatsReady()) {
+        return false;
+    }
+    cpu_power_.update();
+    return true;
+}
+
+bool SystemData::isCpuPowerStatsReady() const {
+    // While the discovery worker is running, cpu_power_ belongs to it.
+    return !sensor_discovery_thread_.joinable() || sensor_discovery_done_;
+}
+
+void SystemData::updateNumaStats() {
+    if (proc_stat_length_ == 0) {
+        readCpuStats();
+    }
+    numa_.update(proc_stat_buffer_.data(), proc_stat_length_);
+}
+
 long SystemData::parseMemInfoLine(const std::string& line, const std::string& key) {
     if (line.rfind(key, 0) == 0) {
         std::stringstream ss(line);
@@ -6,6 +6,13 @@
 #include <map>
 #include <chrono>
 #include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include "irq_stats.h"
+#include "cpu_power_stats.h"
+#include "numa_stats.h"
 
 struct SensorInfo {
     std::string name;
@@ -44,7 +51,22 @@ struct DiskInfo {
 
 class SystemData {
 public:
-    SystemData();
+    explicit SystemData(const std::string& sysfs_root = "/sys");
+    ~SystemData();
+
+    SystemData(const SystemData&) = delete;
+    SystemData& operator=(const SystemData&) = delete;
+
+    // Blocking discovery: scans hwmon and registers every sensor before returning.
+    void discoverSensors();
+
+    // Non-blocking discovery: scans hwmon on a worker thread. Each chip's sensors are queued together
+    // with a first reading, and on_sensors_found is invoked (from the worker thread) after each batch.
+    // The owner drains the queue on its own thread with takeDiscoveredSensors(). The same worker then
+    // discovers the cpufreq/cpuidle/powercap files before reporting that discovery is done.
+    void startSensorDiscovery(std::function<void()> on_sensors_found);
+    std::map<std::string, double> takeDiscoveredSensors();
+    bool isSensorDiscoveryDone() const { return sensor_discovery_done_; }
 
     double getCpuTemperature();
     double getGpuTemperature();
@@ -61,12 +83,37 @@ public:
 
     size_t getMaxHistoryPoints() const { return MAX_HISTORY_POINTS; }
 
+    void updateInterruptStats();
+    const IrqTable& getHardIrqTable() const { return hard_irqs_; }
+    const IrqTable& getSoftIrqTable() const { return soft_irqs_; }
+
+    // Without startSensorDiscovery(), the first call discovers the cpufreq/cpuidle/powercap files.
+    // With it, both return false until the worker has discovered them; getCpuPowerStats() must not be
+    // used before then.
+    bool updateCpuPowerStats();
+    bool isCpuPowerStatsReady() const;
+    const CpuPowerStats& getCpuPowerStats() const { return cpu_power_; }
+
+    // Per-node memory, CPU usage and numastat counters; on machines without NUMA the node list stays empty.
+    // The node CPU usage covers the same interval as the last getCpuUsage() call.
+    void updateNumaStats();
+    const NumaStats& getNumaStats() const { return numa_; }
+
 private:
+    std::string sysfs_root_;
     std::vector<SensorInfo> sensors_;
-    void initializeSensors();
     double readTemperatureFromFile(const std::string& filepath);
-    void findHwmonSensors();
+    void findHwmonSensors(const std::function<void(std::vector<SensorInfo>&)>& on_chip_found);
+
+    std::thread sensor_discovery_thread_;
+    std::mutex pending_sensors_mutex_;
+    std::vector<std::pair<SensorInfo, double>> pending_sensors_;
+    std::atomic<bool> sensor_discovery_done_;
 
+    // /proc/stat is read once per getCpuUsage(); updateNumaStats() reuses that read for the node figures.
+    SysfsFile proc_stat_;
+    std::vector<char> proc_stat_buffer_;
+    size_t proc_stat_length_;
     CpuStats prev_cpu_stats_;
     std::chrono::steady_clock::time_point last_cpu_update_time_;
     std::deque<double> cpu_usage_history_;
@@ -74,6 +121,12 @@ private:
 
     CpuStats readCpuStats();
     long parseMemInfoLine(const std::string& line, const std::string& key);
+
+    IrqTable hard_irqs_;
+    IrqTable soft_irqs_;
+
+    CpuPowerStats cpu_power_;
+    NumaStats numa_;
 };
 
 #endif
\ No newline at end of file
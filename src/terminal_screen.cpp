@@ -0,0 +1,207 @@
+#include "terminal_screen.h"
+#include <clocale>
+#include <cstdlib>
+#include <cwchar>
+#include <cmath>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const wchar_t SPARK_LEVELS[] = L"▁▂▃▄▅▆▇█";
+const wchar_t ASCII_SPARK_LEVELS[] = L" .:-=+*#";
+const int SPARK_LEVEL_COUNT = 8;
+
+}
+
+TerminalScreen::TerminalScreen() : ascii_only_(false), rows_(0), cols_(0), saved_stderr_(-1) {}
+
+void TerminalScreen::begin(int input_poll_ms) {
+    // Collector diagnostics go to stderr; on a shared terminal they would land in the middle of
+    // the screen and never be repainted, so they are silenced while curses owns the terminal.
+    if (isatty(STDERR_FILENO)) {
+        int null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (null_fd >= 0) {
+            saved_stderr_ = dup(STDERR_FILENO);
+            dup2(null_fd, STDERR_FILENO);
+            close(null_fd);
+        }
+    }
+
+    setlocale(LC_ALL, "");
+    ascii_only_ = MB_CUR_MAX == 1;
+    initscr();
+    cbreak();
+    noecho();
+    keypad(stdscr, TRUE);
+    curs_set(0);
+    timeout(input_poll_ms);
+    initColors();
+    resize();
+}
+
+void TerminalScreen::end() {
+    endwin();
+
+    if (saved_stderr_ >= 0) {
+        dup2(saved_stderr_, STDERR_FILENO);
+        close(saved_stderr_);
+        saved_stderr_ = -1;
+    }
+}
+
+void TerminalScreen::initColors() {
+    if (!has_colors()) return;
+    start_color();
+    use_default_colors();
+    init_pair(PAIR_NORMAL, COLOR_GREEN, -1);
+    init_pair(PAIR_WARNING, COLOR_YELLOW, -1);
+    init_pair(PAIR_CRITICAL, COLOR_RED, -1);
+    init_pair(PAIR_TITLE, COLOR_CYAN, -1);
+    init_pair(PAIR_CHART, COLOR_BLUE, -1);
+}
+
+void TerminalScreen::resize() {
+    getmaxyx(stdscr, rows_, cols_);
+    size_t cell_count = static_cast<size_t>(std::max(0, rows_) * std::max(0, cols_));
+    Cell blank = {L' ', A_NORMAL};
+    back_.assign(cell_count, blank);
+    front_.assign(cell_count, blank);
+    run_buffer_.reserve(static_cast<size_t>(std::max(0, cols_)));
+    // The only full repaint: after a resize the terminal contents are undefined.
+    erase();
+    refresh();
+}
+
+void TerminalScreen::clear() {
+    Cell blank = {L' ', A_NORMAL};
+    std::fill(back_.begin(), back_.end(), blank);
+}
+
+void TerminalScreen::flush() {
+    for (int y = 0; y < rows_; ++y) {
+        // The bottom-right cell is never written: addch there would scroll the screen.
+        int row_end = (y == rows_ - 1) ? cols_ - 1 : cols_;
+        int x = 0;
+        while (x < row_end) {
+            size_t index = static_cast<size_t>(y * cols_ + x);
+            if (back_[index] == front_[index]) {
+                ++x;
+                continue;
+            }
+
+            int run_start = x;
+            attr_t run_attr = back_[index].attr;
+            run_buffer_.clear();
+            while (x < row_end) {
+                size_t i = static_cast<size_t>(y * cols_ + x);
+                if (back_[i] == front_[i] || back_[i].attr != run_attr) break;
+                run_buffer_.push_back(back_[i].ch);
+                front_[i] = back_[i];
+                ++x;
+            }
+            attrset(run_attr);
+            mvaddnwstr(y, run_start, run_buffer_.data(), static_cast<int>(run_buffer_.size()));
+        }
+    }
+    attrset(A_NORMAL);
+    refresh();
+}
+
+void TerminalScreen::putChar(int y, int x, wchar_t ch, attr_t attr) {
+    if (y < 0 || y >= rows_ || x < 0 || x >= cols_) return;
+    back_[static_cast<size_t>(y * cols_ + x)] = {ch, attr};
+}
+
+void TerminalScreen::putText(int y, int x, int max_width, const std::string& text, attr_t attr) {
+    std::mbstate_t state = std::mbstate_t();
+    const char* p = text.c_str();
+    const char* end = p + text.size();
+    int column = 0;
+    while (p < end && column < max_width) {
+        wchar_t ch;
+        size_t consumed = std::mbrtowc(&ch, p, static_cast<size_t>(end - p), &state);
+        if (consumed == 0 || consumed == static_cast<size_t>(-1) || consumed == static_cast<size_t>(-2)) {
+            ch = L'?';
+            consumed = 1;
+            state = std::mbstate_t();
+        }
+        putChar(y, x + column, ch, attr);
+        p += consumed;
+        ++column;
+    }
+}
+
+// In a single-byte locale the line characters come from the terminal's alternate character set
+// (or curses' own ASCII fallback), which is what the ACS_ constants resolve to after initscr().
+void TerminalScreen::putLineChar(int y, int x, wchar_t unicode, chtype acs) {
+    if (ascii_only_) {
+        putChar(y, x, static_cast<wchar_t>(acs & A_CHARTEXT), acs & A_ATTRIBUTES);
+    } else {
+        putChar(y, x, unicode, A_NORMAL);
+    }
+}
+
+wchar_t TerminalScreen::sparkLevel(double percent) const {
+    double clamped = std::max(0.0, std::min(100.0, percent));
+    int level = std::min(SPARK_LEVEL_COUNT - 1, static_cast<int>(clamped / 100.0 * SPARK_LEVEL_COUNT));
+    return ascii_only_ ? ASCII_SPARK_LEVELS[level] : SPARK_LEVELS[level];
+}
+
+void TerminalScreen::drawBox(int y, int x, int height, int width, const std::string& title) {
+    if (height < 2 || width < 2) return;
+    for (int i = 1; i < width - 1; ++i) {
+        putLineChar(y, x + i, L'─', ACS_HLINE);
+        putLineChar(y + height - 1, x + i, L'─', ACS_HLINE);
+    }
+    for (int i = 1; i < height - 1; ++i) {
+        putLineChar(y + i, x, L'│', ACS_VLINE);
+        putLineChar(y + i, x + width - 1, L'│', ACS_VLINE);
+    }
+    putLineChar(y, x, L'┌', ACS_ULCORNER);
+    putLineChar(y, x + width - 1, L'┐', ACS_URCORNER);
+    putLineChar(y + height - 1, x, L'└', ACS_LLCORNER);
+    putLineChar(y + height - 1, x + width - 1, L'┘', ACS_LRCORNER);
+    putText(y, x + 2, width - 4, " " + title + " ", COLOR_PAIR(PAIR_TITLE) | A_BOLD);
+}
+
+void TerminalScreen::drawBar(int y, int x, int width, double percent) {
+    if (width < 3) return;
+    int inner = width - 2;
+    int filled = static_cast<int>(std::lround(std::max(0.0, std::min(100.0, percent)) / 100.0 * inner));
+    putChar(y, x, L'[', A_NORMAL);
+    for (int i = 0; i < inner; ++i) {
+        putChar(y, x + 1 + i, i < filled ? L'|' : L' ', percentAttr(percent));
+    }
+    putChar(y, x + width - 1, L']', A_NORMAL);
+}
+
+void TerminalScreen::drawSparkline(int y, int x, int width, const std::deque<double>& history) {
+    // Most recent samples, newest on the right.
+    int spark_width = std::min(width, static_cast<int>(history.size()));
+    for (int i = 0; i < spark_width; ++i) {
+        double value = history[history.size() - static_cast<size_t>(spark_width) + static_cast<size_t>(i)];
+        putChar(y, x + width - spark_width + i, sparkLevel(value), COLOR_PAIR(PAIR_CHART));
+    }
+}
+
+void TerminalScreen::drawLevels(int y, int x, int width, const std::vector<double>& percents) {
+    int count = std::min(width, static_cast<int>(percents.size()));
+    for (int i = 0; i < count; ++i) {
+        if (percents[static_cast<size_t>(i)] < 0) continue;
+        putChar(y, x + i, sparkLevel(percents[static_cast<size_t>(i)]), COLOR_PAIR(PAIR_CHART));
+    }
+}
+
+attr_t TerminalScreen::temperatureAttr(double temp_value) {
+    if (temp_value >= 85.0) return COLOR_PAIR(PAIR_CRITICAL) | A_BOLD;
+    if (temp_value >= 75.0) return COLOR_PAIR(PAIR_WARNING) | A_BOLD;
+    return COLOR_PAIR(PAIR_NORMAL);
+}
+
+attr_t TerminalScreen::percentAttr(double percent) {
+    if (percent >= 90.0) return COLOR_PAIR(PAIR_CRITICAL) | A_BOLD;
+    if (percent >= 75.0) return COLOR_PAIR(PAIR_WARNING);
+    return COLOR_PAIR(PAIR_NORMAL);
+}
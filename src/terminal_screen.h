@@ -0,0 +1,64 @@
+#ifndef TERMINAL_SCREEN_H
+#define TERMINAL_SCREEN_H
+
+#include <curses.h>
+#include <string>
+#include <vector>
+#include <deque>
+
+enum TerminalColorPair { PAIR_NORMAL = 1, PAIR_WARNING, PAIR_CRITICAL, PAIR_TITLE, PAIR_CHART };
+
+// Owns the curses session and a cell back buffer. Callers compose a whole frame with the put/draw
+// helpers; flush() compares it with a mirror of the terminal contents and only sends changed cells.
+class TerminalScreen {
+public:
+    TerminalScreen();
+
+    void begin(int input_poll_ms);
+    void end();
+
+    void resize();
+    void clear();
+    void flush();
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    // "°C", or plain "C" when the locale cannot encode the degree sign.
+    const char* celsiusUnit() const { return ascii_only_ ? "C" : "°C"; }
+
+    void putChar(int y, int x, wchar_t ch, attr_t attr);
+    void putText(int y, int x, int max_width, const std::string& text, attr_t attr);
+    void drawBox(int y, int x, int height, int width, const std::string& title);
+    void drawBar(int y, int x, int width, double percent);
+    void drawSparkline(int y, int x, int width, const std::deque<double>& history);
+    // One block per value, left to right; negative values are left blank.
+    void drawLevels(int y, int x, int width, const std::vector<double>& percents);
+
+    static attr_t temperatureAttr(double temp_value);
+    static attr_t percentAttr(double percent);
+
+private:
+    struct Cell {
+        wchar_t ch;
+        attr_t attr;
+
+        bool operator==(const Cell& other) const { return ch == other.ch && attr == other.attr; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    // back_ is the frame being composed, front_ mirrors what is already on the terminal.
+    std::vector<Cell> back_;
+    std::vector<Cell> front_;
+    std::vector<wchar_t> run_buffer_;
+    // Set when the locale cannot encode box-drawing or block characters (e.g. LANG=C).
+    bool ascii_only_;
+    int rows_;
+    int cols_;
+    int saved_stderr_;
+
+    void initColors();
+    void putLineChar(int y, int x, wchar_t unicode, chtype acs);
+    wchar_t sparkLevel(double percent) const;
+};
+
+#endif
@@ -0,0 +1,389 @@
+#include "terminal_ui.h"
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+const int INPUT_POLL_MS = 100;
+const int MIN_UPDATE_INTERVAL_SECONDS = 1;
+const int MAX_UPDATE_INTERVAL_SECONDS = 10;
+const int TWO_COLUMN_MIN_WIDTH = 80;
+const int POWER_PANEL_HEIGHT = 7;
+
+}
+
+TerminalUI::TerminalUI(SystemData& sys_data) : sysdata(sys_data),
+    running_(false), update_interval_seconds_(2),
+    cpu_usage_(0.0), mem_info_{0, 0, 0, 0, 0.0}, disk_info_{"/", 0, 0, 0, 0.0}, cpu_freq_peak_mhz_(0.0), have_sample_(false)
+{}
+
+void TerminalUI::run() {
+    screen_.begin(INPUT_POLL_MS);
+
+    // First paint happens before any sample; sensors are discovered in the background and polled below.
+    sysdata.startSensorDiscovery(nullptr);
+    render();
+
+    running_ = true;
+    std::chrono::steady_clock::time_point next_sample = std::chrono::steady_clock::now();
+    while (running_) {
+        bool dirty = false;
+
+        int ch = getch();
+        if (ch == KEY_RESIZE) {
+            screen_.resize();
+            dirty = true;
+        } else if (ch != ERR) {
+            handleKey(ch);
+            dirty = true;
+        }
+
+        if (collectDiscoveredSensors()) {
+            dirty = true;
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= next_sample) {
+            sample();
+            next_sample = now + std::chrono::seconds(update_interval_seconds_);
+            dirty = true;
+        }
+
+        if (dirty && running_) {
+            render();
+        }
+    }
+
+    screen_.end();
+}
+
+void TerminalUI::handleKey(int ch) {
+    switch (ch) {
+        case 'q':
+        case 'Q':
+            running_ = false;
+            break;
+        case '+':
+            update_interval_seconds_ = std::min(MAX_UPDATE_INTERVAL_SECONDS, update_interval_seconds_ + 1);
+            break;
+        case '-':
+            update_interval_seconds_ = std::max(MIN_UPDATE_INTERVAL_SECONDS, update_interval_seconds_ - 1);
+            break;
+        default:
+            break;
+    }
+}
+
+void TerminalUI::sample() {
+    cpu_usage_ = sysdata.getCpuUsage();
+    mem_info_ = sysdata.getMemoryInfo();
+    disk_info_ = sysdata.getDiskUsage("/");
+    for (const auto& pair : sysdata.getAllTemperatures()) {
+        temperatures_[pair.first] = pair.second;
+    }
+
+    if (sysdata.updateCpuPowerStats()) {
+        const std::vector<double>& frequencies = sysdata.getCpuPowerStats().frequenciesMhz();
+        for (double mhz : frequencies) {
+            cpu_freq_peak_mhz_ = std::max(cpu_freq_peak_mhz_, mhz);
+        }
+        core_frequency_percents_.resize(frequencies.size());
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            core_frequency_percents_[i] = frequencies[i] < 0 || cpu_freq_peak_mhz_ <= 0 ? -1.0 : frequencies[i] / cpu_freq_peak_mhz_ * 100.0;
+        }
+    }
+
+    sysdata.updateNumaStats();
+    have_sample_ = true;
+}
+
+bool TerminalUI::collectDiscoveredSensors() {
+    auto found = sysdata.takeDiscoveredSensors();
+    for (const auto& pair : found) {
+        temperatures_[pair.first] = pair.second;
+    }
+    return !found.empty();
+}
+
+void TerminalUI::render() {
+    screen_.clear();
+    int rows = screen_.rows();
+    int cols = screen_.cols();
+
+    drawHeader();
+
+    int body_top = 1;
+    int body_height = rows - 2;
+    if (body_height > 0) {
+        if (cols >= TWO_COLUMN_MIN_WIDTH) {
+            int left_width = cols / 2;
+            int right_width = cols - left_width;
+            int numa_height = numaPanelHeight(body_height / 2);
+            drawTemperaturePanel(body_top, 0, body_height - numa_height, left_width);
+            drawNumaPanel(body_top + body_height - numa_height, 0, numa_height, left_width);
+            drawCpuPanel(body_top, left_width, 6, right_width);
+            drawMemoryPanel(body_top + 6, left_width, 6, right_width);
+            drawDiskPanel(body_top + 12, left_width, 6, right_width);
+            drawPowerPanel(body_top + 18, left_width, body_height - 18, right_width);
+        } else {
+            int power_height = std::min(POWER_PANEL_HEIGHT, (body_height - 18) / 2);
+            int numa_height = numaPanelHeight((body_height - 18 - power_height) / 2);
+            drawCpuPanel(body_top, 0, 6, cols);
+            drawMemoryPanel(body_top + 6, 0, 6, cols);
+            drawDiskPanel(body_top + 12, 0, 6, cols);
+            drawTemperaturePanel(body_top + 18, 0, body_height - 18 - power_height - numa_height, cols);
+            drawNumaPanel(body_top + body_height - power_height - numa_height, 0, numa_height, cols);
+            drawPowerPanel(body_top + body_height - power_height, 0, power_height, cols);
+        }
+    }
+
+    drawFooter();
+    screen_.flush();
+}
+
+void TerminalUI::drawHeader() {
+    int cols = screen_.cols();
+    for (int x = 0; x < cols; ++x) {
+        screen_.putChar(0, x, L' ', A_REVERSE);
+    }
+    screen_.putText(0, 1, cols - 2, "System Monitor", A_REVERSE | A_BOLD);
+}
+
+void TerminalUI::drawFooter() {
+    int rows = screen_.rows();
+    int cols = screen_.cols();
+    if (rows < 2) return;
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "q: quit  +/-: update interval (%d s)", update_interval_seconds_);
+    screen_.putText(rows - 1, 1, cols - 2, buf, A_DIM);
+}
+
+void TerminalUI::drawTemperaturePanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "Temperature (CPU/GPU/Other)");
+
+    int inner_width = width - 4;
+    int line = y + 1;
+    int last_line = y + height - 2;
+
+    if (temperatures_.empty()) {
+        screen_.putText(line, x + 2, inner_width,
+                sysdata.isSensorDiscoveryDone() ? "No temperature sensors found" : "Discovering sensors...", A_DIM);
+        return;
+    }
+
+    int shown = 0;
+    int total = static_cast<int>(temperatures_.size());
+    for (const auto& pair : temperatures_) {
+        if (line > last_line) break;
+        if (line == last_line && shown + 1 < total) {
+            char more[48];
+            std::snprintf(more, sizeof(more), "... %d more", total - shown);
+            screen_.putText(line, x + 2, inner_width, more, A_DIM);
+            break;
+        }
+
+        char value[32];
+        attr_t attr = A_NORMAL;
+        if (pair.second != -1.0) {
+            std::snprintf(value, sizeof(value), "%ld %s", std::lround(pair.second), screen_.celsiusUnit());
+            attr = TerminalScreen::temperatureAttr(pair.second);
+        } else {
+            std::snprintf(value, sizeof(value), "Error");
+        }
+        int value_width = 8;
+        screen_.putText(line, x + 2, inner_width - value_width - 1, pair.first, A_NORMAL);
+        screen_.putText(line, x + 2 + inner_width - value_width, value_width, value, attr);
+        ++line;
+        ++shown;
+    }
+}
+
+void TerminalUI::drawCpuPanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "CPU Usage");
+    int inner_width = width - 4;
+
+    char buf[64];
+    if (!have_sample_) {
+        std::snprintf(buf, sizeof(buf), "Current Usage: N/A");
+    } else if (cpu_usage_ >= 0) {
+        std::snprintf(buf, sizeof(buf), "Current Usage: %.1f %%", cpu_usage_);
+    } else {
+        std::snprintf(buf, sizeof(buf), "Current Usage: Error");
+    }
+    screen_.putText(y + 1, x + 2, inner_width, buf, A_NORMAL);
+    if (have_sample_ && cpu_usage_ >= 0) {
+        screen_.drawBar(y + 2, x + 2, inner_width, cpu_usage_);
+    }
+
+    int spark_line = y + 3;
+    if (spark_line < y + height - 1) {
+        screen_.drawSparkline(spark_line, x + 2, inner_width, sysdata.getCpuUsageHistory());
+    }
+}
+
+void TerminalUI::drawMemoryPanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "Memory (RAM)");
+    int inner_width = width - 4;
+
+    char buf[96];
+    if (!have_sample_) {
+        screen_.putText(y + 1, x + 2, inner_width, "N/A", A_DIM);
+        return;
+    }
+    if (mem_info_.total_kb <= 0) {
+        screen_.putText(y + 1, x + 2, inner_width, "Error", COLOR_PAIR(PAIR_CRITICAL));
+        return;
+    }
+
+    double total_gb = static_cast<double>(mem_info_.total_kb) / (1024.0 * 1024.0);
+    double used_gb = static_cast<double>(mem_info_.used_kb) / (1024.0 * 1024.0);
+    double free_gb = static_cast<double>(mem_info_.available_kb) / (1024.0 * 1024.0);
+
+    std::snprintf(buf, sizeof(buf), "Total: %.2f GB", total_gb);
+    screen_.putText(y + 1, x + 2, inner_width, buf, A_NORMAL);
+    std::snprintf(buf, sizeof(buf), "Used: %.2f GB  Free: %.2f GB", used_gb, free_gb);
+    screen_.putText(y + 2, x + 2, inner_width, buf, A_NORMAL);
+    std::snprintf(buf, sizeof(buf), "Usage: %.1f %%", mem_info_.usage_percent);
+    screen_.putText(y + 3, x + 2, inner_width, buf, TerminalScreen::percentAttr(mem_info_.usage_percent));
+    if (height > 5) {
+        screen_.drawBar(y + 4, x + 2, inner_width, mem_info_.usage_percent);
+    }
+}
+
+void TerminalUI::drawDiskPanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "Disk Usage (Root '/')");
+    int inner_width = width - 4;
+
+    char buf[96];
+    if (!have_sample_) {
+        screen_.putText(y + 1, x + 2, inner_width, "N/A", A_DIM);
+        return;
+    }
+    if (disk_info_.total_space_gb < 0) {
+        screen_.putText(y + 1, x + 2, inner_width, "Error", COLOR_PAIR(PAIR_CRITICAL));
+        return;
+    }
+
+    std::snprintf(buf, sizeof(buf), "Total: %ld GB", disk_info_.total_space_gb);
+    screen_.putText(y + 1, x + 2, inner_width, buf, A_NORMAL);
+    std::snprintf(buf, sizeof(buf), "Used: %ld GB  Free: %ld GB", disk_info_.used_space_gb, disk_info_.free_space_gb);
+    screen_.putText(y + 2, x + 2, inner_width, buf, A_NORMAL);
+    std::snprintf(buf, sizeof(buf), "Usage: %.1f %%", disk_info_.usage_percent);
+    screen_.putText(y + 3, x + 2, inner_width, buf, TerminalScreen::percentAttr(disk_info_.usage_percent));
+    if (height > 5) {
+        screen_.drawBar(y + 4, x + 2, inner_width, disk_info_.usage_percent);
+    }
+}
+
+void TerminalUI::drawPowerPanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "CPU Frequency & Power");
+    int inner_width = width - 4;
+    int line = y + 1;
+    int last_line = y + height - 2;
+
+    if (!have_sample_) {
+        screen_.putText(line, x + 2, inner_width, "N/A", A_DIM);
+        return;
+    }
+
+    if (!sysdata.isCpuPowerStatsReady()) {
+        screen_.putText(line, x + 2, inner_width, "Reading cpufreq...", A_DIM);
+        return;
+    }
+
+    const CpuPowerStats& power = sysdata.getCpuPowerStats();
+    double total_mhz = 0.0;
+    int freq_count = 0;
+    for (double mhz : power.frequenciesMhz()) {
+        if (mhz < 0) continue;
+        total_mhz += mhz;
+        ++freq_count;
+    }
+    if (freq_count == 0 && power.idleStateNames().empty() && power.raplDomains().empty()) {
+        screen_.putText(line, x + 2, inner_width, "No cpufreq, cpuidle or RAPL data available", A_DIM);
+        return;
+    }
+
+    char buf[128];
+    if (freq_count > 0) {
+        std::snprintf(buf, sizeof(buf), "Freq: avg %ld MHz  peak %ld MHz",
+                std::lround(total_mhz / freq_count), std::lround(cpu_freq_peak_mhz_));
+        screen_.putText(line++, x + 2, inner_width, buf, A_NORMAL);
+        if (line <= last_line) {
+            screen_.drawLevels(line++, x + 2, inner_width, core_frequency_percents_);
+        }
+    }
+
+    // Remaining lines are filled with "name value" items, packed left to right.
+    std::vector<std::string> items;
+    for (const RaplDomain& domain : power.raplDomains()) {
+        std::snprintf(buf, sizeof(buf), "%s %.1f W", domain.name.c_str(), domain.watts);
+        items.push_back(buf);
+    }
+    for (size_t state = 0; state < power.idleStateNames().size(); ++state) {
+        std::snprintf(buf, sizeof(buf), "%s %.1f %%", power.idleStateNames()[state].c_str(),
+                power.averageIdleResidencyPercent(state));
+        items.push_back(buf);
+    }
+
+    int column = 0;
+    for (const std::string& item : items) {
+        int item_width = static_cast<int>(item.size());
+        if (column > 0 && column + 2 + item_width > inner_width) {
+            ++line;
+            column = 0;
+        }
+        if (line > last_line) break;
+        if (column > 0) column += 2;
+        screen_.putText(line, x + 2 + column, inner_width - column, item, A_NORMAL);
+        column += item_width;
+    }
+}
+
+int TerminalUI::numaPanelHeight(int available_height) const {
+    const NumaStats& numa = sysdata.getNumaStats();
+    if (!numa.isAvailable()) return 0;
+    // Two lines per node (figures and a CPU sparkline), plus a note on single-node machines.
+    int wanted = 2 + static_cast<int>(numa.nodes().size()) * 2 + (numa.isMultiNode() ? 0 : 1);
+    int height = std::min(wanted, available_height);
+    return height >= 3 ? height : 0;
+}
+
+void TerminalUI::drawNumaPanel(int y, int x, int height, int width) {
+    if (height < 3) return;
+    screen_.drawBox(y, x, height, width, "NUMA Nodes");
+    int inner_width = width - 4;
+    int line = y + 1;
+    int last_line = y + height - 2;
+
+    const NumaStats& numa = sysdata.getNumaStats();
+    if (!numa.isMultiNode()) {
+        screen_.putText(line++, x + 2, inner_width, "Single NUMA node", A_DIM);
+    }
+
+    char buf[128];
+    const std::vector<NumaNode>& nodes = numa.nodes();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (line > last_line) break;
+        if (line == last_line && i + 1 < nodes.size()) {
+            std::snprintf(buf, sizeof(buf), "... %zu more", nodes.size() - i);
+            screen_.putText(line, x + 2, inner_width, buf, A_DIM);
+            break;
+        }
+
+        const NumaNode& node = nodes[i];
+        std::snprintf(buf, sizeof(buf), "node%d [%s]  CPU %5.1f %%  Mem %5.1f %% of %.1f GB  miss %.0f/s",
+                node.id, node.cpu_list.c_str(), node.cpu_usage_percent, node.mem_usage_percent,
+                static_cast<double>(node.mem_total_kb) / (1024.0 * 1024.0), node.miss_per_second);
+        screen_.putText(line++, x + 2, inner_width, buf, TerminalScreen::percentAttr(std::max(node.cpu_usage_percent, node.mem_usage_percent)));
+        if (line <= last_line) {
+            screen_.drawSparkline(line++, x + 2, inner_width, node.cpu_history);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef TERMINAL_UI_H
+#define TERMINAL_UI_H
+
+#include "terminal_screen.h"
+#include "system_data.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <chrono>
+
+class TerminalUI {
+public:
+    TerminalUI(SystemData& sys_data);
+    void run();
+
+private:
+    SystemData& sysdata;
+
+    TerminalScreen screen_;
+
+    bool running_;
+    int update_interval_seconds_;
+
+    double cpu_usage_;
+    MemoryInfo mem_info_;
+    DiskInfo disk_info_;
+    std::map<std::string, double> temperatures_;
+    std::vector<double> core_frequency_percents_;
+    double cpu_freq_peak_mhz_;
+    bool have_sample_;
+
+    void handleKey(int ch);
+    void sample();
+    bool collectDiscoveredSensors();
+
+    void render();
+
+    void drawHeader();
+    void drawFooter();
+    void drawTemperaturePanel(int y, int x, int height, int width);
+    void drawCpuPanel(int y, int x, int height, int width);
+    void drawMemoryPanel(int y, int x, int height, int width);
+    void drawDiskPanel(int y, int x, int height, int width);
+    void drawPowerPanel(int y, int x, int height, int width);
+    int numaPanelHeight(int available_height) const;
+    void drawNumaPanel(int y, int x, int height, int width);
+};
+
+#endif